@@ -0,0 +1,600 @@
+/**
+ * @file
+ * @brief Benchmarks source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains realisation of converter stages benchmarks
+ */
+
+#include <srm.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/**
+ * Measure average time of function call
+ * @param[in] func function to measure
+ * @param[in] repeats number of repeats
+ * @return average time in seconds
+ */
+template <typename func_t>
+  static double _measure(func_t func, unsigned repeats) {
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < repeats; i++)
+      func();
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    return time.count() / repeats;
+  }
+
+/**
+ * Write benchmark result line
+ * @param[in] out stream to write results
+ * @param[in] name name of measured variant
+ * @param[in] time average time in seconds
+ * @param[in] bytes number of processed bytes
+ */
+static void _writeThroughput(std::ostream &out, const std::string &name, double time, size_t bytes) {
+  out << std::setw(24) << std::left << name << std::right << std::fixed << std::setprecision(3) <<
+    std::setw(12) << time * 1000 << " ms" <<
+    std::setw(12) << bytes / time / (1024 * 1024) << " MB/s" << std::endl;
+}
+
+/**
+ * Write benchmark result line with rate of items
+ * @param[in] out stream to write results
+ * @param[in] name name of measured variant
+ * @param[in] time average time in seconds
+ * @param[in] count number of processed items
+ * @param[in] unit name of items
+ */
+static void _writeRate(std::ostream &out, const std::string &name, double time, size_t count, const std::string &unit) {
+  out << std::setw(24) << std::left << name << std::right << std::fixed << std::setprecision(3) <<
+    std::setw(12) << time * 1000 << " ms" <<
+    std::setw(16) << std::setprecision(0) << count / time << " " << unit << "/s" << std::endl;
+}
+
+/**
+ * Write benchmark result line with number of items per nanosecond
+ * @param[in] out stream to write results
+ * @param[in] name name of measured variant
+ * @param[in] time average time in seconds
+ * @param[in] count number of processed items
+ * @param[in] unit name of items
+ */
+static void _writePerNs(std::ostream &out, const std::string &name, double time, size_t count, const std::string &unit) {
+  out << std::setw(24) << std::left << name << std::right << std::fixed << std::setprecision(3) <<
+    std::setw(12) << time * 1000 << " ms" <<
+    std::setw(12) << count / time * 1e-9 << " " << unit << "/ns" << std::endl;
+}
+
+/**
+ * Load svg file with previous loader: line by line reading, concatenation and copy
+ * @param[in] svgFileName svg file name
+ * @return heap buffer with file data without newlines
+ */
+static char * _loadByLines(const std::string &svgFileName) {
+  std::ifstream fin(svgFileName);
+  if (!fin.is_open())
+    throw std::exception("Failed to open intput file");
+
+  std::string buf;
+  std::string line;
+  while (std::getline(fin, line))
+    buf += line;
+
+  char *xmlString = new char[buf.length() + 1];
+  memcpy(xmlString, buf.c_str(), buf.length() + 1);
+  return xmlString;
+}
+
+/**
+ * Svg file loading benchmark: line by line reading (previous loader), single read and memory mapping
+ * @param[in] out stream to write results
+ * @param[in] svgFileName svg file name
+ * @param[in] repeats number of repeats
+ */
+void srm::bench::LoadSvg(std::ostream &out, const std::string &svgFileName, unsigned repeats) {
+  svg_file_t file;
+  file.Load(svgFileName);
+  size_t bytes = file.GetSize();
+  out << "File: " << svgFileName << " (" << bytes << " bytes, " <<
+    (file.IsMapped() ? "mappable" : "not mappable, mapping falls back to read") << ")" << std::endl;
+  file.Close();
+
+  double time;
+  time = _measure([&]() {
+    delete[] _loadByLines(svgFileName);
+    }, repeats);
+  _writeThroughput(out, "lines load", time, bytes);
+  time = _measure([&]() {
+    file.Load(svgFileName, false);
+    }, repeats);
+  _writeThroughput(out, "read load", time, bytes);
+  time = _measure([&]() {
+    file.Load(svgFileName, true);
+    }, repeats);
+  _writeThroughput(out, "mapping load", time, bytes);
+
+  rapidxml::xml_document<> doc;
+  time = _measure([&]() {
+    char *xmlString = _loadByLines(svgFileName);
+    doc.clear();
+    doc.parse<rapidxml::parse_full>(xmlString);
+    delete[] xmlString;
+    }, repeats);
+  _writeThroughput(out, "lines load + parse", time, bytes);
+  time = _measure([&]() {
+    doc.clear();
+    file.Load(svgFileName, false);
+    doc.parse<rapidxml::parse_full>(file.GetData());
+    }, repeats);
+  _writeThroughput(out, "read load + parse", time, bytes);
+  time = _measure([&]() {
+    doc.clear();
+    file.Load(svgFileName, true);
+    doc.parse<rapidxml::parse_full>(file.GetData());
+    }, repeats);
+  _writeThroughput(out, "mapping load + parse", time, bytes);
+  doc.clear();
+}
+
+/**
+ * Collect path nodes of DOM in document order
+ * @param[in] node pointer to node in xml DOM
+ * @param[out] paths path nodes
+ */
+static void _collectPaths(const rapidxml::xml_node<> *node, std::vector<const rapidxml::xml_node<> *> *paths) {
+  for (auto child = node->first_node(); child != nullptr; child = child->next_sibling()) {
+    if (strcmp(child->name(), "path") == 0 && child->first_attribute("d") != nullptr)
+      paths->push_back(child);
+    _collectPaths(child, paths);
+  }
+}
+
+/**
+ * Path data parsing benchmark: all d attributes of svg file are parsed to geometry
+ * @param[in] out stream to write results
+ * @param[in] svgFileName svg file name
+ * @param[in] confFileName robot configuration file name (sets sampling accuracy of curves)
+ * @param[in] repeats number of repeats
+ */
+void srm::bench::ParsePath(std::ostream &out, const std::string &svgFileName, const std::string &confFileName, unsigned repeats) {
+  const double defaultWidth = 300, defaultHeight = 150;
+  std::ostringstream log;
+  conversion_context_t ctx(&log);
+  ctx.roboConf.LoadConf(confFileName);
+  ctx.svgFile.Load(svgFileName);
+  try {
+    ctx.xmlTree.parse<rapidxml::parse_default>(ctx.svgFile.GetData());
+  }
+  catch (rapidxml::parse_error err) {
+    throw std::exception("Error in the svg file");
+  }
+  auto svg = ctx.xmlTree.first_node("svg");
+  if (svg == nullptr)
+    throw std::exception("Error in the svg file");
+
+  // sampling accuracy depends on svg size like in conversion
+  double width = 0, height = 0;
+  if (svg->last_attribute("width"))
+    ParseLength(svg->last_attribute("width")->value(), defaultWidth, &width);
+  if (svg->last_attribute("height"))
+    ParseLength(svg->last_attribute("height")->value(), defaultHeight, &height);
+  ctx.roboConf.SetWH(width > 0 ? width : defaultWidth, height > 0 ? height : defaultHeight);
+
+  std::vector<const rapidxml::xml_node<> *> paths;
+  _collectPaths(svg, &paths);
+  size_t bytes = 0;
+  for (auto path : paths)
+    bytes += path->first_attribute("d")->value_size();
+  out << "File: " << svgFileName << " (" << paths.size() << " paths, " << bytes << " bytes of path data)" << std::endl;
+
+  double time = _measure([&]() {
+    ctx.shapes.Clear();
+    for (auto path : paths) {
+      path_t parser(&ctx, &ctx.shapes, transform_t());
+      parser.ParsePath(path);
+    }
+    }, repeats);
+  _writeThroughput(out, "path parse", time, bytes);
+  out << "Points: " << ctx.shapes.x.size() << ", primitives: " << ctx.shapes.Size() << ", " <<
+    std::setprecision(0) << ctx.shapes.x.size() / time << " points/s" << std::endl;
+}
+
+/**
+ * Bezier sampling benchmark: generic de Casteljau evaluator (build_bezier_t) against degree-specialised one (bezier_t)
+ * and sampling by chord length against sampling by flatness (one by one and batched)
+ * @param[in] out stream to write results
+ * @param[in] repeats number of repeats
+ */
+void srm::bench::SampleBezier(std::ostream &out, unsigned repeats) {
+  const size_t numOfCurves = 1000;
+  const double size = 100, accuracy = 0.05;
+  std::mt19937 generator(30);
+  std::uniform_real_distribution<double> coord(0, size);
+  std::vector<std::array<vec_t, 3>> quadratic(numOfCurves);
+  std::vector<std::array<vec_t, 4>> cubic(numOfCurves);
+  for (auto &curve : quadratic)
+    for (auto &point : curve)
+      point = vec_t(coord(generator), coord(generator));
+  for (auto &curve : cubic)
+    for (auto &point : curve)
+      point = vec_t(coord(generator), coord(generator));
+  out << "Curves: " << numOfCurves << " quadratic and " << numOfCurves << " cubic in " << size << "x" << size <<
+    " box, accuracy " << accuracy << std::endl;
+
+  size_t numOfPoints = 0;
+  double time = _measure([&]() {
+    numOfPoints = 0;
+    build_bezier_t bezier;
+    for (const auto &curve : quadratic) {
+      bezier.assign(curve.begin(), curve.end());
+      numOfPoints += bezier.Sampling(accuracy).size();
+    }
+    for (const auto &curve : cubic) {
+      bezier.assign(curve.begin(), curve.end());
+      numOfPoints += bezier.Sampling(accuracy).size();
+    }
+    }, repeats);
+  _writeRate(out, "generic sampling", time, numOfPoints, "points");
+
+  geometry_t geom;
+  std::vector<vec_t> tail;
+  time = _measure([&]() {
+    geom.Clear();
+    for (const auto &curve : quadratic)
+      bezier_t<2>(curve).Sampling(accuracy, &geom, &tail);
+    for (const auto &curve : cubic)
+      bezier_t<3>(curve).Sampling(accuracy, &geom, &tail);
+    }, repeats);
+  _writeRate(out, "specialised sampling", time, geom.x.size(), "points");
+  size_t numOfChordPoints = geom.x.size();
+
+  time = _measure([&]() {
+    geom.Clear();
+    for (const auto &curve : quadratic)
+      bezier_t<2>(curve).SamplingByFlatness(accuracy, &geom);
+    for (const auto &curve : cubic)
+      bezier_t<3>(curve).SamplingByFlatness(accuracy, &geom);
+    }, repeats);
+  _writeRate(out, "flatness sampling", time, geom.x.size(), "points");
+
+  // batched points of every instruction set are checked to be the same as one by one ones
+  std::vector<double> flatX = geom.x, flatY = geom.y;
+  bezier_batch_t batch;
+  for (auto isa : {kernels::isa_t::scalar, kernels::isa_t::sse2, kernels::isa_t::avx2}) {
+    if (isa > kernels::GetBestIsa())
+      break;
+    time = _measure([&]() {
+      geom.Clear();
+      for (const auto &curve : quadratic)
+        batch.AddByFlatness(bezier_t<2>(curve), accuracy, &geom);
+      for (const auto &curve : cubic)
+        batch.AddByFlatness(bezier_t<3>(curve), accuracy, &geom);
+      batch.Flush(&geom, isa);
+      }, repeats);
+    _writeRate(out, std::string("batched flatness ") + kernels::GetIsaName(isa), time, geom.x.size(), "points");
+    if (geom.x != flatX || geom.y != flatY)
+      throw std::exception("Batched flattening differs from one by one");
+  }
+  out << "Points: " << numOfChordPoints << " by chord length, " << geom.x.size() << " by flatness (" <<
+    std::setprecision(1) << 100.0 * (1 - (double)geom.x.size() / numOfChordPoints) << "% less)" << std::endl;
+}
+
+/**
+ * Sample ellipse with previous algorithm: halving of parameter step and trigonometry for every point
+ * @param[in] center ellipse center point
+ * @param[in] radiuses 2 ellipse radiuses by x and y
+ * @param[in] accuracy sampling accuracy
+ * @return point vector with sampling
+ */
+static std::vector<srm::vec_t> _ellipseByHalving(srm::vec_t center, srm::vec_t radiuses, double accuracy) {
+  double accuracy2 = accuracy * accuracy, param = srm::pi, angle0, dist2;
+  unsigned numOfPoints = 2;
+  srm::vec_t p0;
+  if (radiuses.x > radiuses.y) {
+    p0.x += radiuses.x;
+    angle0 = 0;
+  }
+  else {
+    p0.y += radiuses.y;
+    angle0 = srm::pi / 2;
+  }
+
+  do {
+    param /= 2;
+    numOfPoints *= 2;
+    double angle = angle0 + param;
+    dist2 = (srm::vec_t(radiuses.x * cos(angle), radiuses.y * sin(angle)) - p0).Len2();
+  } while (dist2 > accuracy2);
+
+  std::vector<srm::vec_t> res(numOfPoints + 1);
+  for (unsigned i = 0; i < numOfPoints; i++) {
+    double angle = 2 * srm::pi * i / numOfPoints;
+    res[i] = srm::vec_t(center.x + radiuses.x * cos(angle), center.y + radiuses.y * sin(angle));
+  }
+  res[numOfPoints] = res[0];
+  return res;
+}
+
+/**
+ * Sample arc of ellipse with previous algorithm: midpoints insertion to list with trigonometry for every point
+ * @param[in] center ellipse center point
+ * @param[in] radiuses 2 ellipse radiuses by x and y
+ * @param[in] param1 parameter of the first point
+ * @param[in] param2 parameter of the last point
+ * @param[in] accuracy sampling accuracy
+ * @return point vector with sampling
+ */
+static std::vector<srm::vec_t> _arcByList(srm::vec_t center, srm::vec_t radiuses, double param1, double param2, double accuracy) {
+  auto point = [&](double param) {
+    return srm::vec_t(center.x + radiuses.x * cos(param), center.y + radiuses.y * sin(param));
+  };
+  std::list<std::pair<double, srm::vec_t>> sampling;
+  sampling.push_back(std::make_pair(param1, point(param1)));
+  sampling.push_back(std::make_pair((param1 + param2) / 2, point((param1 + param2) / 2)));
+  sampling.push_back(std::make_pair(param2, point(param2)));
+
+  auto cur = sampling.begin();
+  auto next = std::next(cur);
+  double accuracy2 = accuracy * accuracy;
+  while (next != sampling.end()) {
+    if ((cur->second - next->second).Len2() < accuracy2) {
+      cur = next;
+      next++;
+    }
+    else {
+      double med = (cur->first + next->first) / 2;
+      next = sampling.insert(next, std::make_pair(med, point(med)));
+    }
+  }
+
+  std::vector<srm::vec_t> res;
+  for (auto &p : sampling)
+    res.push_back(p.second);
+  return res;
+}
+
+/**
+ * Ellipse sampling benchmark: previous sampling (step halving, list refinement and trigonometry per point) against
+ * analytic number of segments with incremental rotation on circle-heavy documents
+ * @param[in] out stream to write results
+ * @param[in] repeats number of repeats
+ */
+void srm::bench::SampleEllipses(std::ostream &out, unsigned repeats) {
+  /**
+   * @brief Quarter arc of rounded pad corner
+   */
+  struct corner_t {
+    vec_t
+      center,  ///< center of corner circle
+      p1,      ///< first arc point
+      p2;      ///< second arc point
+    double
+      radius,  ///< radius of corner circle
+      param;   ///< parameter of the first point
+  };
+  const size_t gridSize = 100, numOfPads = 5000;
+  const double pitch = 2.54, dotRadius = 0.6, accuracy = 0.05;
+  std::mt19937 generator(30);
+  std::uniform_real_distribution<double> coord(0, gridSize * pitch), radius(0.3, 3);
+  std::vector<std::pair<vec_t, double>> dots, pads;
+  std::vector<corner_t> corners;
+
+  // dot matrix: equal circles on grid
+  for (size_t i = 0; i < gridSize; i++)
+    for (size_t j = 0; j < gridSize; j++)
+      dots.push_back(std::make_pair(vec_t(i * pitch, j * pitch), dotRadius));
+  // PCB: round pads and vias of different sizes and rounded rectangle pads (4 quarter arcs each)
+  for (size_t i = 0; i < numOfPads; i++) {
+    vec_t center(coord(generator), coord(generator));
+    double r = radius(generator);
+    if (i % 2 == 0)
+      pads.push_back(std::make_pair(center, r));
+    else
+      for (unsigned k = 0; k < 4; k++) {
+        double param = k * pi / 2;
+        vec_t
+          p1 = center + vec_t(r * cos(param), r * sin(param)),
+          p2 = center + vec_t(r * cos(param + pi / 2), r * sin(param + pi / 2));
+        corners.push_back({center, p1, p2, r, param});
+      }
+  }
+  out << "Dot matrix: " << dots.size() << " circles, PCB: " << pads.size() << " round pads and " << corners.size() <<
+    " corner arcs, accuracy " << accuracy << std::endl;
+
+  size_t numOfPoints = 0;
+  double time = _measure([&]() {
+    numOfPoints = 0;
+    for (const auto &dot : dots)
+      numOfPoints += _ellipseByHalving(dot.first, vec_t(dot.second, dot.second), accuracy).size();
+    }, repeats);
+  _writeRate(out, "dots halving", time, numOfPoints, "points");
+
+  geometry_t geom;
+  time = _measure([&]() {
+    geom.Clear();
+    for (const auto &dot : dots)
+      EllipseSampling(dot.first, vec_t(dot.second, 0), vec_t(0, dot.second), accuracy, &geom);
+    }, repeats);
+  _writeRate(out, "dots rotation", time, geom.x.size(), "points");
+
+  time = _measure([&]() {
+    numOfPoints = 0;
+    for (const auto &pad : pads)
+      numOfPoints += _ellipseByHalving(pad.first, vec_t(pad.second, pad.second), accuracy).size();
+    for (const auto &corner : corners)
+      numOfPoints += _arcByList(corner.center, vec_t(corner.radius, corner.radius), corner.param,
+        corner.param + pi / 2, accuracy).size();
+    }, repeats);
+  _writeRate(out, "pads halving and list", time, numOfPoints, "points");
+
+  time = _measure([&]() {
+    geom.Clear();
+    for (const auto &pad : pads)
+      EllipseSampling(pad.first, vec_t(pad.second, 0), vec_t(0, pad.second), accuracy, &geom);
+    for (const auto &corner : corners)
+      EllipseArcSampling(GetEllipseArc(corner.p1, corner.p2, vec_t(corner.radius, corner.radius), false, true, 0,
+        transform_t()), accuracy, &geom);
+    }, repeats);
+  _writeRate(out, "pads rotation", time, geom.x.size(), "points");
+}
+
+/**
+ * Coordinate kernels benchmark: affine transformation and svg to robot scaling of contiguous arrays
+ * by every instruction set supported by processor
+ * @param[in] out stream to write results
+ * @param[in] repeats number of repeats
+ */
+void srm::bench::RunKernels(std::ostream &out, unsigned repeats) {
+  // arrays are small like coordinates of primitives and stay in cache, so kernels are measured, not memory
+  const size_t numOfPoints = 1 << 12, numOfPasses = 256;
+  const double matrix[2][3] = { {0.8, -0.6, 12.5}, {0.6, 0.8, -3.25} };
+  std::mt19937 generator(30);
+  std::uniform_real_distribution<double> coord(0, 1000);
+  std::vector<double> x(numOfPoints), y(numOfPoints), resX(numOfPoints), resY(numOfPoints);
+  for (size_t i = 0; i < numOfPoints; i++) {
+    x[i] = coord(generator);
+    y[i] = coord(generator);
+  }
+  kernels::isa_t best = kernels::GetBestIsa();
+  out << "Points: " << numOfPoints << " x " << numOfPasses << " passes, the best instruction set: " <<
+    kernels::GetIsaName(best) << std::endl;
+
+  for (auto isa : {kernels::isa_t::scalar, kernels::isa_t::sse2, kernels::isa_t::avx2}) {
+    if (isa > best)
+      break;
+    std::string name = kernels::GetIsaName(isa);
+    // matrix is rotation with shift, so repeated application keeps coordinates finite
+    double time = _measure([&]() {
+      for (size_t pass = 0; pass < numOfPasses; pass++)
+        kernels::Affine(matrix, x.data(), y.data(), numOfPoints, isa);
+      }, repeats);
+    _writePerNs(out, "affine " + name, time, numOfPoints * numOfPasses, "points");
+    time = _measure([&]() {
+      for (size_t pass = 0; pass < numOfPasses; pass++)
+        kernels::Scale(0.5, 2.0, x.data(), y.data(), resX.data(), resY.data(), numOfPoints, isa);
+      }, repeats);
+    _writePerNs(out, "scale " + name, time, numOfPoints * numOfPasses, "points");
+  }
+}
+
+/**
+ * Fill hatching benchmark: big region with holes is hatched by fine step with 1 to maximal number of threads,
+ * parallel code is checked to be the same as serial one
+ * @param[in] out stream to write results
+ * @param[in] confFileName robot configuration file name (sets canvas of robot)
+ * @param[in] maxThreads maximal number of threads
+ * @param[in] repeats number of repeats
+ */
+void srm::bench::HatchRegion(std::ostream &out, const std::string &confFileName, unsigned maxThreads,
+  unsigned repeats) {
+  const size_t numOfHoles = 20;
+  const double size = 1000, holeRadius = 15, step = 0.01, accuracy = 0.5;
+  std::ostringstream log;
+  conversion_context_t ctx(&log);
+  ctx.roboConf.LoadConf(confFileName);
+  ctx.roboConf.SetWH(size, size);
+  ctx.roboConf.SetPouringStep(step);
+
+  // background with grid of round holes: one region of many contours filled by even-odd rule
+  geometry_t geom;
+  for (vec_t p : {vec_t(0, 0), vec_t(size, 0), vec_t(size, size), vec_t(0, size), vec_t(0, 0)})
+    geom.Add(p);
+  geom.Close(geometry_t::fill | geometry_t::evenOdd);
+  double pitch = size / numOfHoles;
+  for (size_t i = 0; i < numOfHoles; i++)
+    for (size_t j = 0; j < numOfHoles; j++) {
+      EllipseSampling(vec_t((i + 0.5) * pitch, (j + 0.5) * pitch), vec_t(holeRadius, 0), vec_t(0, holeRadius),
+        accuracy, &geom);
+      geom.Close(geometry_t::fill | geometry_t::evenOdd | geometry_t::subpath);
+    }
+
+  out << "Region: " << geom.Size() << " contours, " << geom.x.size() << " points, step " << step <<
+    " in robot coordinates, hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+  std::ostringstream code;
+  std::string serialCode;
+  size_t numOfSegments = 0;
+  double serialTime = 0;
+  for (unsigned threads = 1; ; threads = std::min(2 * threads, maxThreads)) {
+    ctx.numOfFillThreads = threads;
+    double time = _measure([&]() {
+      code.str("");
+      numOfSegments = srm::FillRegion(&ctx, code, geom, 0, geom.Size());
+      }, repeats);
+    if (threads == 1) {
+      serialCode = code.str();
+      serialTime = time;
+    }
+    else if (code.str() != serialCode)
+      throw std::exception("Parallel hatching differs from serial one");
+    std::ostringstream name;
+    name << threads << " threads x" << std::fixed << std::setprecision(2) << serialTime / time;
+    _writeRate(out, name.str(), time, numOfSegments, "segments");
+    if (threads == maxThreads)
+      break;
+  }
+}
+
+/**
+ * Run benchmark by command line function
+ * @param[in] argC number of benchmark arguments
+ * @param[in] argV benchmark arguments (name of benchmark is first)
+ * @return system code (0 if success)
+ */
+int srm::bench::Run(int argC, char *argV[]) {
+  const unsigned defaultRepeats = 10;
+  if (argC < 1) {
+    std::cout << "Error: benchmark name is not set" << std::endl;
+    return 0;
+  }
+
+  std::string name(argV[0]);
+  unsigned repeats = defaultRepeats;
+  if (name == "load" && argC == 3 && std::atoi(argV[2]) > 0)
+    repeats = (unsigned)std::atoi(argV[2]);
+  else if (name == "path" && argC == 4 && std::atoi(argV[3]) > 0)
+    repeats = (unsigned)std::atoi(argV[3]);
+  else if (name == "fill" && argC == 4 && std::atoi(argV[3]) > 0)
+    repeats = (unsigned)std::atoi(argV[3]);
+  else if ((name == "bezier" || name == "ellipse" || name == "kernels") && argC == 2 && std::atoi(argV[1]) > 0)
+    repeats = (unsigned)std::atoi(argV[1]);
+  try {
+    if (name == "load" && (argC == 2 || argC == 3))
+      LoadSvg(std::cout, argV[1], repeats);
+    else if (name == "path" && (argC == 3 || argC == 4))
+      ParsePath(std::cout, argV[1], argV[2], repeats);
+    else if (name == "bezier" && (argC == 1 || argC == 2))
+      SampleBezier(std::cout, repeats);
+    else if (name == "ellipse" && (argC == 1 || argC == 2))
+      SampleEllipses(std::cout, repeats);
+    else if (name == "kernels" && (argC == 1 || argC == 2))
+      RunKernels(std::cout, repeats);
+    else if (name == "fill" && (argC >= 2 && argC <= 4)) {
+      unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+      if (argC >= 3 && std::atoi(argV[2]) > 0)
+        maxThreads = (unsigned)std::atoi(argV[2]);
+      HatchRegion(std::cout, argV[1], maxThreads, repeats);
+    }
+    else {
+      std::cout << "Error: wrong benchmark params" << std::endl;
+      return 0;
+    }
+  }
+  catch (std::exception &e) {
+    std::cout << "Error: " << e.what() << std::endl;
+    return 0;
+  }
+  return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file
+ * @brief Benchmarks header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains declaration of converter stages benchmarks
+ */
+
+#pragma once
+
+#ifndef __BENCH_H_INCLUDED
+#define __BENCH_H_INCLUDED
+
+#include <ostream>
+#include <string>
+
+/** \brief Project namespace */
+namespace srm {
+  /** \brief Benchmarks namespace */
+  namespace bench {
+    /**
+     * Run benchmark by command line function
+     * @param[in] argC number of benchmark arguments
+     * @param[in] argV benchmark arguments (name of benchmark is first)
+     * @return system code (0 if success)
+     */
+    int Run(int argC, char *argV[]);
+
+    /**
+     * Svg file loading benchmark: line by line reading (previous loader), single read and memory mapping
+     * @param[in] out stream to write results
+     * @param[in] svgFileName svg file name
+     * @param[in] repeats number of repeats
+     */
+    void LoadSvg(std::ostream &out, const std::string &svgFileName, unsigned repeats);
+
+    /**
+     * Path data parsing benchmark: all d attributes of svg file are parsed to geometry
+     * @param[in] out stream to write results
+     * @param[in] svgFileName svg file name
+     * @param[in] confFileName robot configuration file name (sets sampling accuracy of curves)
+     * @param[in] repeats number of repeats
+     */
+    void ParsePath(std::ostream &out, const std::string &svgFileName, const std::string &confFileName, unsigned repeats);
+
+    /**
+     * Bezier sampling benchmark: generic de Casteljau evaluator (build_bezier_t) against degree-specialised one (bezier_t)
+     * and sampling by chord length against sampling by flatness (one by one and batched)
+     * @param[in] out stream to write results
+     * @param[in] repeats number of repeats
+     */
+    void SampleBezier(std::ostream &out, unsigned repeats);
+
+    /**
+     * Ellipse sampling benchmark: previous sampling (step halving, list refinement and trigonometry per point) against
+     * analytic number of segments with incremental rotation on circle-heavy documents
+     * @param[in] out stream to write results
+     * @param[in] repeats number of repeats
+     */
+    void SampleEllipses(std::ostream &out, unsigned repeats);
+
+    /**
+     * Coordinate kernels benchmark: affine transformation and svg to robot scaling of contiguous arrays
+     * by every instruction set supported by processor
+     * @param[in] out stream to write results
+     * @param[in] repeats number of repeats
+     */
+    void RunKernels(std::ostream &out, unsigned repeats);
+
+    /**
+     * Fill hatching benchmark: big region with holes is hatched by fine step with 1 to maximal number of threads,
+     * parallel code is checked to be the same as serial one
+     * @param[in] out stream to write results
+     * @param[in] confFileName robot configuration file name (sets canvas of robot)
+     * @param[in] maxThreads maximal number of threads
+     * @param[in] repeats number of repeats
+     */
+    void HatchRegion(std::ostream &out, const std::string &confFileName, unsigned maxThreads, unsigned repeats);
+  }
+}
+
+#endif /* __BENCH_H_INCLUDED */
@@ -0,0 +1,69 @@
+/**
+ * @file
+ * @brief Monotonic arena allocator class source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains arena_t class realisation to allocate many small objects of one conversion
+ */
+
+#include <srm.h>
+
+/**
+ * Constructor for arena_t
+ * @param[in] defBlockSize default size of new block in bytes
+ */
+srm::arena_t::arena_t(size_t defBlockSize) noexcept : curBlock(0), used(0), blockSize(defBlockSize) {
+}
+
+/**
+ * Allocate memory function
+ * @param[in] size size of memory in bytes
+ * @param[in] align alignment of memory (not more than alignment of std::max_align_t)
+ * @return pointer to allocated memory
+ */
+void * srm::arena_t::Allocate(size_t size, size_t align) {
+  // blocks from new[] are aligned for any type, so offsets are aligned
+  for (; curBlock < blocks.size(); curBlock++, used = 0) {
+    size_t offset = (used + align - 1) & ~(align - 1);
+    if (offset + size <= blocks[curBlock].size) {
+      used = offset + size;
+      return blocks[curBlock].data + offset;
+    }
+  }
+
+  block_t block;
+  block.size = size > blockSize ? size : blockSize;
+  block.data = new char[block.size];
+  blocks.push_back(block);
+  curBlock = blocks.size() - 1;
+  used = size;
+  return block.data;
+}
+
+/**
+ * Free all allocated objects at once function. Blocks are kept for reuse
+ */
+void srm::arena_t::Reset(void) noexcept {
+  curBlock = 0;
+  used = 0;
+}
+
+/**
+ * Get size of all blocks function
+ * @return size of reserved memory in bytes
+ */
+size_t srm::arena_t::GetReserved(void) const noexcept {
+  size_t size = 0;
+  for (const auto &block : blocks)
+    size += block.size;
+  return size;
+}
+
+/**
+ * Class destructor
+ */
+srm::arena_t::~arena_t(void) noexcept {
+  for (auto &block : blocks)
+    delete[] block.data;
+}
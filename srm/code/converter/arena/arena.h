@@ -0,0 +1,93 @@
+/**
+ * @file
+ * @brief Monotonic arena allocator class header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains arena_t class description to allocate many small objects of one conversion
+ */
+
+#pragma once
+
+#ifndef __ARENA_H_INCLUDED
+#define __ARENA_H_INCLUDED
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * @brief Monotonic arena allocator class
+   *
+   * Allocates memory by bumping pointer in big blocks. Objects are never freed one by one:
+   * whole arena is reset at once and its blocks are reused by the next conversion.
+   */
+  class arena_t {
+  private:
+    /**
+     * @brief Arena memory block struct
+     */
+    struct block_t {
+      char *data;   ///< block memory
+      size_t size;  ///< block size in bytes
+    };
+
+    std::vector<block_t> blocks;  ///< all allocated blocks
+    size_t
+      curBlock,                   ///< index of block to allocate from
+      used,                       ///< number of used bytes in current block
+      blockSize;                  ///< default size of new block
+
+  public:
+    /**
+     * Constructor for arena_t
+     * @param[in] defBlockSize default size of new block in bytes
+     */
+    arena_t(size_t defBlockSize = 64 * 1024) noexcept;
+
+    arena_t(const arena_t &) = delete;
+    arena_t & operator=(const arena_t &) = delete;
+
+    /**
+     * Allocate memory function
+     * @param[in] size size of memory in bytes
+     * @param[in] align alignment of memory (not more than alignment of std::max_align_t)
+     * @return pointer to allocated memory
+     */
+    void * Allocate(size_t size, size_t align);
+
+    /**
+     * Create object in arena function
+     * @param[in] args constructor arguments
+     * @return pointer to created object
+     * @warning destructor is never called, so only trivially destructible types are allowed
+     */
+    template <typename type_t, typename... args_t>
+      type_t * New(args_t &&...args) {
+        static_assert(std::is_trivially_destructible<type_t>::value, "Arena objects are never destroyed");
+        return new (Allocate(sizeof(type_t), alignof(type_t))) type_t(std::forward<args_t>(args)...);
+      }
+
+    /**
+     * Free all allocated objects at once function. Blocks are kept for reuse
+     */
+    void Reset(void) noexcept;
+
+    /**
+     * Get size of all blocks function
+     * @return size of reserved memory in bytes
+     */
+    size_t GetReserved(void) const noexcept;
+
+    /**
+     * Class destructor
+     */
+    ~arena_t(void) noexcept;
+  };
+}
+
+#endif /* __ARENA_H_INCLUDED */
@@ -0,0 +1,293 @@
+/**
+ * @file
+ * @brief Batch conversion source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains realisation of function to convert many svg files on worker pool
+ */
+
+#include <srm.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/** \brief Project namespace */
+namespace srm {
+  /** \brief Batch conversion namespace */
+  namespace batch {
+    /**
+     * @brief Batch job struct
+     *
+     * Struct to save one conversion job while it moves through read, convert and write stages
+     */
+    struct job_t {
+      size_t id = 0;             ///< number of job in manifest
+      std::string
+        svgFileName,             ///< svg file name
+        codeFileName,            ///< code file name
+        confFileName;            ///< robot configuration file name
+      svg_file_t svgFile;        ///< loaded svg file
+      std::string code;          ///< generated code
+      std::string log;           ///< conversion warnings
+      stats_t stats;             ///< conversion statistics
+      double
+        readTime = 0,            ///< time of svg reading in seconds
+        convTime = 0,            ///< time of conversion in seconds
+        writeTime = 0;           ///< time of code writing in seconds
+      std::string error;         ///< error message (empty if success)
+    };
+
+    /**
+     * @brief Bounded blocking queue class
+     *
+     * Queue to pass jobs between stages threads
+     */
+    template <typename type_t>
+      class queue_t {
+      private:
+        std::mutex mutex;                    ///< items guard
+        std::condition_variable
+          notEmpty,                          ///< signaled when item is pushed or queue is closed
+          notFull;                           ///< signaled when item is popped
+        std::deque<type_t> items;            ///< queue items
+        size_t capacity;                     ///< maximal number of items
+        bool isClosed = false;               ///< true if no more items will be pushed
+
+      public:
+        /**
+         * Constructor for queue_t
+         * @param[in] cap maximal number of items
+         */
+        queue_t(size_t cap) : capacity(cap) {
+        }
+
+        /**
+         * Push item, wait if queue is full
+         * @param[in] item item to push
+         */
+        void Push(type_t &&item) {
+          std::unique_lock<std::mutex> lock(mutex);
+          notFull.wait(lock, [this]() { return items.size() < capacity; });
+          items.push_back(std::move(item));
+          notEmpty.notify_one();
+        }
+
+        /**
+         * Pop item, wait if queue is empty
+         * @param[out] item popped item
+         * @return true if item is popped, false if queue is closed and empty
+         */
+        bool Pop(type_t *item) {
+          std::unique_lock<std::mutex> lock(mutex);
+          notEmpty.wait(lock, [this]() { return !items.empty() || isClosed; });
+          if (items.empty())
+            return false;
+          *item = std::move(items.front());
+          items.pop_front();
+          notFull.notify_one();
+          return true;
+        }
+
+        /**
+         * Close queue: no more items will be pushed
+         */
+        void Close(void) {
+          std::lock_guard<std::mutex> lock(mutex);
+          isClosed = true;
+          notEmpty.notify_all();
+        }
+      };
+
+    using job_queue_t = queue_t<std::unique_ptr<job_t>>;
+  }
+}
+
+/**
+ * Get seconds since time point
+ * @param[in] start time point
+ * @return seconds
+ */
+static double _secondsFrom(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Read manifest file
+ * @param[in] manifestFileName manifest file name
+ * @param[out] jobs jobs from manifest
+ */
+static void _readManifest(const std::string &manifestFileName, std::vector<std::unique_ptr<srm::batch::job_t>> *jobs) {
+  std::ifstream fin(manifestFileName);
+  if (!fin.is_open())
+    throw std::exception("Failed to open manifest file");
+
+  std::string line;
+  size_t lineNum = 0;
+  while (std::getline(fin, line)) {
+    lineNum++;
+    std::istringstream iss(line);
+    auto job = std::make_unique<srm::batch::job_t>();
+    if (!(iss >> job->svgFileName) || job->svgFileName[0] == '#')
+      continue;
+    std::string check;
+    if (!(iss >> job->codeFileName >> job->confFileName) || (iss >> check))
+      throw std::exception((std::string("Incorrect number of parameters in manifest in line #") + std::to_string(lineNum)).c_str());
+    job->id = jobs->size() + 1;
+    jobs->push_back(std::move(job));
+  }
+}
+
+/**
+ * Convert svg files from manifest on fixed-size worker pool.
+ * Each manifest line contains svg file name, code file name and robot configuration file name.
+ * Reading of next inputs and writing of finished outputs is overlapped with conversion.
+ * @param[in] manifestFileName manifest file name
+ * @param[in] numOfThreads number of conversion threads
+ * @param[in] report stream to write per-job and aggregate throughput
+ * @return number of failed jobs
+ */
+size_t srm::ConvertBatch(const std::string &manifestFileName, unsigned numOfThreads, std::ostream &report) {
+  if (numOfThreads == 0)
+    numOfThreads = 1;
+
+  std::vector<std::unique_ptr<batch::job_t>> jobs;
+  _readManifest(manifestFileName, &jobs);
+
+  // every configuration is loaded once for all jobs
+  std::map<std::string, robot_conf_t> confs;
+  std::map<std::string, std::string> confErrors;
+  for (auto &job : jobs) {
+    if (confs.count(job->confFileName) != 0 || confErrors.count(job->confFileName) != 0)
+      continue;
+    try {
+      confs[job->confFileName].LoadConf(job->confFileName);
+    }
+    catch (std::exception &e) {
+      confs.erase(job->confFileName);
+      confErrors[job->confFileName] = e.what();
+    }
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  batch::job_queue_t
+    readQueue(2 * (size_t)numOfThreads),
+    writeQueue(2 * (size_t)numOfThreads);
+
+  // reader: inputs are read ahead while previous ones are converted
+  std::thread reader([&]() {
+    for (auto &job : jobs) {
+      auto readStart = std::chrono::steady_clock::now();
+      auto confError = confErrors.find(job->confFileName);
+      if (confError != confErrors.end())
+        job->error = confError->second;
+      else {
+        try {
+          // single read, so disk work is done here and not in page faults of converter
+          job->svgFile.Load(job->svgFileName, false);
+        }
+        catch (std::exception &e) {
+          job->error = e.what();
+        }
+      }
+      job->readTime = _secondsFrom(readStart);
+      readQueue.Push(std::move(job));
+    }
+    readQueue.Close();
+    });
+
+  // converters: each worker has its own translator with its own context, so no locks are needed.
+  // Context memory is reused from job to job, so steady state does not allocate
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < numOfThreads; i++)
+    workers.emplace_back([&]() {
+      translator_t trans;
+      const robot_conf_t *lastConf = nullptr;  // configuration of the previous job of worker
+      std::unique_ptr<batch::job_t> job;
+      while (readQueue.Pop(&job)) {
+        if (job->error.empty()) {
+          auto convStart = std::chrono::steady_clock::now();
+          std::ostringstream log;
+          trans.context.SetLog(&log);
+          try {
+            std::ostringstream out;
+            // configuration is copied only when it changes, otherwise only svg size of previous document is reset
+            const robot_conf_t &conf = confs.at(job->confFileName);
+            if (&conf != lastConf) {
+              lastConf = nullptr;
+              trans.context.roboConf = conf;
+              lastConf = &conf;
+            }
+            else
+              trans.context.roboConf.SetWH(conf.GetW(), conf.GetH());
+            trans.SetSvg(std::move(job->svgFile));
+            trans.GenCode(out);
+            job->code = out.str();
+            job->stats = trans.GetStats();
+          }
+          catch (std::exception &e) {
+            job->error = e.what();
+          }
+          trans.context.SetLog(&std::cout);
+          job->log = log.str();
+          job->convTime = _secondsFrom(convStart);
+        }
+        writeQueue.Push(std::move(job));
+      }
+      });
+
+  // writer: outputs are written while next ones are converted
+  size_t numOfFailed = 0, numOfDone = 0;
+  stats_t total;
+  std::thread writer([&]() {
+    std::unique_ptr<batch::job_t> job;
+    while (writeQueue.Pop(&job)) {
+      if (job->error.empty()) {
+        auto writeStart = std::chrono::steady_clock::now();
+        std::ofstream fout(job->codeFileName, std::ios::binary);
+        if (!fout.is_open() || !fout.write(job->code.data(), job->code.size()))
+          job->error = "Failed to open or create output file";
+        job->writeTime = _secondsFrom(writeStart);
+      }
+
+      std::ostringstream line;
+      line << "Job #" << job->id << " " << job->svgFileName << " -> " << job->codeFileName << ": ";
+      if (job->error.empty()) {
+        numOfDone++;
+        total += job->stats;
+        line << std::fixed << std::setprecision(3) << job->stats <<
+          ", read " << job->readTime * 1000 << " ms, convert " << job->convTime * 1000 <<
+          " ms, write " << job->writeTime * 1000 << " ms, " <<
+          std::setprecision(0) << job->stats.segments / job->convTime << " segments/s\n";
+      }
+      else {
+        numOfFailed++;
+        line << "Error: " << job->error << "\n";
+      }
+      report << job->log << line.str();
+      job.reset();
+    }
+    });
+
+  reader.join();
+  for (auto &worker : workers)
+    worker.join();
+  writeQueue.Close();
+  writer.join();
+
+  double time = _secondsFrom(start);
+  report << "Total: " << numOfDone << " files converted, " << numOfFailed << " failed, " << total <<
+    " on " << numOfThreads << " threads in " << std::fixed << std::setprecision(3) << time << " s, " <<
+    std::setprecision(2) << numOfDone / time << " files/s, " <<
+    std::setprecision(0) << total.segments / time << " segments/s" << std::endl;
+  return numOfFailed;
+}
@@ -0,0 +1,32 @@
+/**
+ * @file
+ * @brief Batch conversion header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains declaration of function to convert many svg files on worker pool
+ */
+
+#pragma once
+
+#ifndef __BATCH_H_INCLUDED
+#define __BATCH_H_INCLUDED
+
+#include <ostream>
+#include <string>
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * Convert svg files from manifest on fixed-size worker pool.
+   * Each manifest line contains svg file name, code file name and robot configuration file name.
+   * Reading of next inputs and writing of finished outputs is overlapped with conversion.
+   * @param[in] manifestFileName manifest file name
+   * @param[in] numOfThreads number of conversion threads
+   * @param[in] report stream to write per-job and aggregate throughput
+   * @return number of failed jobs
+   */
+  size_t ConvertBatch(const std::string &manifestFileName, unsigned numOfThreads, std::ostream &report);
+}
+
+#endif /* __BATCH_H_INCLUDED */
@@ -0,0 +1,56 @@
+/**
+ * @file
+ * @brief Conversion context class source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains conversion_context_t class realisation to keep all state of one conversion
+ */
+
+#include <srm.h>
+
+/**
+ * Constructor for conversion_context_t
+ * @param[in] log stream to make logs
+ */
+srm::conversion_context_t::conversion_context_t(std::ostream *log) noexcept : logStream(log) {
+}
+
+/**
+ * Set stream to make logs function
+ * @param[in] log stream to make logs
+ */
+void srm::conversion_context_t::SetLog(std::ostream *log) noexcept {
+  logStream = log;
+}
+
+/**
+ * Get stream to make logs function
+ * @return stream to make logs
+ */
+std::ostream * srm::conversion_context_t::GetLog(void) const noexcept {
+  return logStream;
+}
+
+/**
+ * Write string in log stream function
+ * @param[in] str string to write
+ */
+void srm::conversion_context_t::WriteLog(const std::string &str) noexcept {
+  *logStream << str << std::endl;
+}
+
+/**
+ * Release all objects of conversion at once function.
+ * Memory is kept, so next conversion with this context does not allocate in steady state
+ */
+void srm::conversion_context_t::Release(void) {
+  tags.clear();
+  culledNodes.clear();
+  arena.Reset();
+  shapes.Clear();
+  splitted.Clear();
+  pieces.Clear();
+  shapeCache.Clear();
+  transforms.Clear();
+}
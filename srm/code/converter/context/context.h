@@ -0,0 +1,107 @@
+/**
+ * @file
+ * @brief Conversion context class header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains conversion_context_t class description to keep all state of one conversion
+ */
+
+#pragma once
+
+#ifndef __CONTEXT_H_INCLUDED
+#define __CONTEXT_H_INCLUDED
+
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "../rapidxml.hpp"
+#include "../robot_conf/robot_conf.h"
+#include "../svg_file/svg_file.h"
+#include "../stats/stats.h"
+#include "../arena/arena.h"
+#include "../geometry/geometry.h"
+#include "../shape_cache/shape_cache.h"
+#include "../fill/scanline/scanline.h"
+#include "../fill/cells/cells.h"
+#include "../fill/offset/offset.h"
+#include "../fill/angle/angle.h"
+#include "../tags_translator/transform/transform_cache.h"
+#include "../tags_translator/path/bezier/bezier_batch.h"
+#include "../tags_translator/tag/tag.h"
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * @brief Conversion context class
+   *
+   * Owns DOM, robot configuration, logging sink and scratch buffers of one conversion.
+   * Context is passed through the whole pipeline, so different contexts may be used in parallel without locks.
+   */
+  class conversion_context_t {
+  private:
+    std::ostream *logStream;            ///< stream to make logs
+
+  public:
+    svg_file_t svgFile;                 ///< rapidxml parses this file buffer in situ, so it lives while DOM is used
+    rapidxml::xml_document<> xmlTree;   ///< the root of xml DOM
+    robot_conf_t roboConf;              ///< robot configuration
+    stats_t stats;                      ///< statistics of the last conversion
+
+    arena_t arena;                      ///< arena for tags and other trivially destructible objects of conversion
+    std::vector<tag_t *> tags;          ///< tags of DOM in document order (allocated in arena)
+    std::unordered_set<const rapidxml::xml_node<> *> culledNodes;  ///< elements of DOM found out of sheet before their conversion
+
+    geometry_t
+      shapes,                           ///< primitives of tags
+      splitted,                         ///< primitives splitted by svg borders
+      pieces;                           ///< scratch pieces of one splitted primitive
+    std::vector<vec_t> curveTail;       ///< scratch points of curve sampled from its end
+    std::vector<double> codeBuf;        ///< scratch robot coordinates of primitive being written
+    bezier_batch_t curves;              ///< curves of the open primitive to flatten at once
+    shape_cache_t shapeCache;           ///< sampled outlines of circles and ellipses of conversion
+    scanline_t scanline;                ///< edge table of region being filled
+    std::vector<scanline_t::cursor_t> fillCursors;  ///< cursors of hatch bands of region being filled
+    cells_t fillCells;                  ///< boustrophedon cells of region being filled
+    offset_fill_t fillOffsets;          ///< offset contours of region being filled
+    hatch_angle_t hatchAngle;           ///< hatch angle optimiser of region being filled
+    unsigned numOfFillThreads = 1;      ///< number of threads to hatch bands of one region (1 - serial hatching)
+    transform_cache_t transforms;       ///< parsed transform attributes of conversion by text
+
+    /**
+     * Constructor for conversion_context_t
+     * @param[in] log stream to make logs
+     */
+    conversion_context_t(std::ostream *log) noexcept;
+
+    conversion_context_t(const conversion_context_t &) = delete;
+    conversion_context_t & operator=(const conversion_context_t &) = delete;
+
+    /**
+     * Set stream to make logs function
+     * @param[in] log stream to make logs
+     */
+    void SetLog(std::ostream *log) noexcept;
+
+    /**
+     * Get stream to make logs function
+     * @return stream to make logs
+     */
+    std::ostream * GetLog(void) const noexcept;
+
+    /**
+     * Write string in log stream function
+     * @param[in] str string to write
+     */
+    void WriteLog(const std::string &str) noexcept;
+
+    /**
+     * Release all objects of conversion at once function.
+     * Memory is kept, so next conversion with this context does not allocate in steady state
+     */
+    void Release(void);
+  };
+}
+
+#endif /* __CONTEXT_H_INCLUDED */
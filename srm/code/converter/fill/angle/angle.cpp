@@ -0,0 +1,130 @@
+/**
+ * @file
+ * @brief Hatch angle optimiser class source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains hatch_angle_t class realisation to choose direction of hatch lines by estimated robot time
+ */
+
+#include <srm.h>
+
+#include <algorithm>
+#include <thread>
+
+/**
+ * Estimate cost of hatching along direction function
+ * @param[in, out] worker buffers of evaluating thread
+ * @param[in] roboConf robot configuration (sets step, velocity and departure distance)
+ * @param[in] geom geometry with region for filling
+ * @param[in] begin index of the first primitive (contour) of region
+ * @param[in] end index after the last primitive (contour) of region
+ * @param[in] x, y robot coordinates of region points (from the first point of region)
+ * @param[in] rule rule of region interior
+ * @param[in, out] cost cost with set direction to estimate
+ */
+void srm::hatch_angle_t::Estimate(worker_t *worker, const robot_conf_t &roboConf, const geometry_t &geom,
+  size_t begin, size_t end, const double *x, const double *y, scanline_t::rule_t rule, cost_t *cost) {
+  // big regions are estimated by subset of hatch lines, counts are scaled back to the real step
+  const double maxNumOfLines = 256;
+  vec_t e1 = cost->dir, e2(-e1.y, e1.x);
+  size_t base = geom.Begin(begin), n = geom.End(end - 1) - base;
+  worker->u.resize(n);
+  worker->v.resize(n);
+  double *u = worker->u.data(), *v = worker->v.data();
+  double vMin = 1e60, vMax = -1e60;
+  for (size_t i = 0; i < n; i++) {
+    u[i] = x[i] * e1.x + y[i] * e1.y;
+    v[i] = x[i] * e2.x + y[i] * e2.y;
+    vMin = std::min(vMin, v[i]);
+    vMax = std::max(vMax, v[i]);
+  }
+
+  scanline_t &scanline = worker->scanline;
+  scanline.Clear();
+  for (size_t prim = begin; prim < end; prim++) {
+    size_t first = geom.Begin(prim) - base;
+    scanline.AddContour(u + first, v + first, geom.End(prim) - geom.Begin(prim));
+  }
+  scanline.Sort();
+  scanline.Start(&worker->cursor);
+
+  double step = roboConf.GetPouringStep(), sampleStep = std::max(step, (vMax - vMin) / maxNumOfLines);
+  size_t numOfLines = vMax > vMin ? (size_t)ceil((vMax - vMin) / sampleStep) : 0, numOfSegments = 0;
+  double paint = 0, travel = 0, scale = sampleStep / step;
+  vec_t last;
+  for (size_t line = 0; line < numOfLines; line++) {
+    double lineV = vMin + line * sampleStep;
+    const std::vector<double> &spans = scanline.GetSpans(&worker->cursor, lineV, rule);
+    size_t numOfSpans = spans.size() / 2;
+    for (size_t k = 0; k < numOfSpans; k++) {
+      // lines alternate like in filling, travel across lines is taken for the real step
+      size_t i = line % 2 == 1 ? 2 * k : 2 * (numOfSpans - 1 - k);
+      double u1 = spans[i], u2 = spans[i + 1];
+      if (u1 == u2)
+        continue;
+      if (line % 2 == 0)
+        std::swap(u1, u2);
+      if (numOfSegments != 0)
+        travel += hypot(u1 - last.x, (lineV - last.y) / scale);
+      paint += fabs(u2 - u1);
+      last = vec_t(u2, lineV);
+      numOfSegments++;
+    }
+  }
+
+  // every segment is painted with approach and departure
+  cost->numOfSegments = (size_t)(numOfSegments * scale + 0.5);
+  cost->time = ((paint + travel) * scale + cost->numOfSegments * 2 * roboConf.GetDepDist()) /
+    roboConf.GetVelocity();
+}
+
+/**
+ * Choose direction of hatch lines function
+ * @param[in] roboConf robot configuration (sets step, velocity and departure distance)
+ * @param[in] geom geometry with region for filling
+ * @param[in] begin index of the first primitive (contour) of region
+ * @param[in] end index after the last primitive (contour) of region
+ * @param[in] x, y robot coordinates of region points (from the first point of region)
+ * @param[in] rule rule of region interior
+ * @param[in] principal direction of principal axis of region
+ * @param[in] numOfThreads number of evaluating threads
+ * @return costs of the chosen direction and of principal axis
+ */
+std::pair<srm::hatch_angle_t::cost_t, srm::hatch_angle_t::cost_t> srm::hatch_angle_t::Choose(
+  const robot_conf_t &roboConf, const geometry_t &geom, size_t begin, size_t end, const double *x, const double *y,
+  scanline_t::rule_t rule, vec_t principal, unsigned numOfThreads) {
+  // principal axis goes first, so it is kept if no angle is cheaper
+  const size_t numOfAngles = 12;
+  // workers estimate not less points than this, so thread start is negligible and small regions are serial
+  const size_t minPointsPerWorker = 1 << 14;
+  costs.resize(numOfAngles + 1);
+  costs[0].dir = principal;
+  for (size_t i = 0; i < numOfAngles; i++) {
+    double angle = pi * i / numOfAngles;
+    costs[i + 1].dir = vec_t(cos(angle), sin(angle));
+  }
+
+  size_t
+    numOfPoints = geom.End(end - 1) - geom.Begin(begin),
+    numOfWorkers = std::max<size_t>(1, std::min<size_t>(std::min<size_t>(numOfThreads, costs.size()),
+      numOfPoints * costs.size() / minPointsPerWorker));
+  if (workers.size() < numOfWorkers)
+    workers.resize(numOfWorkers);
+  auto estimate = [&](size_t worker) {
+    for (size_t i = worker; i < costs.size(); i += numOfWorkers)
+      Estimate(&workers[worker], roboConf, geom, begin, end, x, y, rule, &costs[i]);
+  };
+  std::vector<std::thread> threads;
+  for (size_t worker = 1; worker < numOfWorkers; worker++)
+    threads.emplace_back(estimate, worker);
+  estimate(0);
+  for (auto &thread : threads)
+    thread.join();
+
+  size_t best = 0;
+  for (size_t i = 1; i < costs.size(); i++)
+    if (costs[i].time < costs[best].time)
+      best = i;
+  return std::make_pair(costs[best], costs[0]);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file
+ * @brief Hatch angle optimiser class header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains hatch_angle_t class description to choose direction of hatch lines by estimated robot time
+ */
+
+#pragma once
+
+#ifndef __ANGLE_H_INCLUDED
+#define __ANGLE_H_INCLUDED
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "../../defs.h"
+#include "../../geometry/geometry.h"
+#include "../../robot_conf/robot_conf.h"
+#include "../scanline/scanline.h"
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * @brief Hatch angle optimiser class
+   *
+   * Candidate directions (principal axis of region and uniform angles) are evaluated by scanline engine:
+   * number of hatch segments, painting length and travel between segments give estimated robot time,
+   * the cheapest direction is chosen. Every segment is estimated with approach and departure, so the model is for
+   * hatching by lines. Candidates of big regions are evaluated in parallel by their own scanline engines.
+   * Buffers are kept between regions, so choosing does not allocate in steady state
+   */
+  class hatch_angle_t {
+  public:
+    /**
+     * @brief Estimated cost of hatching along direction
+     */
+    struct cost_t {
+      vec_t dir;                   ///< direction of hatch lines
+      size_t numOfSegments = 0;    ///< estimated number of hatch segments
+      double time = 0;             ///< estimated robot time, s
+    };
+
+  private:
+    /**
+     * @brief Buffers of one evaluating thread
+     */
+    struct worker_t {
+      scanline_t scanline;         ///< edge table of region in candidate basis
+      scanline_t::cursor_t cursor; ///< cursor of scanning
+      std::vector<double> u, v;    ///< coordinates of region points in candidate basis
+    };
+
+    std::vector<worker_t> workers; ///< buffers of evaluating threads
+    std::vector<cost_t> costs;     ///< costs of candidates
+
+    /**
+     * Estimate cost of hatching along direction function
+     * @param[in, out] worker buffers of evaluating thread
+     * @param[in] roboConf robot configuration (sets step, velocity and departure distance)
+     * @param[in] geom geometry with region for filling
+     * @param[in] begin index of the first primitive (contour) of region
+     * @param[in] end index after the last primitive (contour) of region
+     * @param[in] x, y robot coordinates of region points (from the first point of region)
+     * @param[in] rule rule of region interior
+     * @param[in, out] cost cost with set direction to estimate
+     */
+    static void Estimate(worker_t *worker, const robot_conf_t &roboConf, const geometry_t &geom, size_t begin,
+      size_t end, const double *x, const double *y, scanline_t::rule_t rule, cost_t *cost);
+
+  public:
+    /**
+     * Choose direction of hatch lines function
+     * @param[in] roboConf robot configuration (sets step, velocity and departure distance)
+     * @param[in] geom geometry with region for filling
+     * @param[in] begin index of the first primitive (contour) of region
+     * @param[in] end index after the last primitive (contour) of region
+     * @param[in] x, y robot coordinates of region points (from the first point of region)
+     * @param[in] rule rule of region interior
+     * @param[in] principal direction of principal axis of region
+     * @param[in] numOfThreads number of evaluating threads
+     * @return costs of the chosen direction and of principal axis
+     */
+    std::pair<cost_t, cost_t> Choose(const robot_conf_t &roboConf, const geometry_t &geom, size_t begin, size_t end,
+      const double *x, const double *y, scanline_t::rule_t rule, vec_t principal, unsigned numOfThreads);
+  };
+}
+
+#endif /* __ANGLE_H_INCLUDED */
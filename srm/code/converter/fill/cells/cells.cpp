@@ -0,0 +1,85 @@
+/**
+ * @file
+ * @brief Boustrophedon cells of hatch lines class source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains cells_t class realisation to decompose hatch spans of region into monotone cells
+ */
+
+#include <srm.h>
+
+/**
+ * Constructor for cells_t
+ */
+srm::cells_t::cells_t(void) : lines(1, 0) {
+}
+
+/**
+ * Remove all lines keeping capacity function
+ */
+void srm::cells_t::Clear(void) noexcept {
+  spans.clear();
+  lines.resize(1);
+  next.clear();
+  prev.clear();
+  joined.clear();
+}
+
+/**
+ * Mark overlapping of 2 spans function
+ * @param[in, out] link link of span to mark
+ * @param[in] span index of overlapping span
+ */
+void srm::cells_t::Overlap(size_t *link, size_t span) noexcept {
+  *link = *link == none ? span : several;
+}
+
+/**
+ * Add spans of the next line and link them to spans of the previous line function
+ * @param[in] lineSpans ends of spans of line in increasing order (span i is [res[2 * i], res[2 * i + 1]]),
+ *                      empty spans are skipped
+ */
+void srm::cells_t::AddLine(const std::vector<double> &lineSpans) {
+  for (size_t i = 0; i + 1 < lineSpans.size(); i += 2) {
+    if (lineSpans[i] == lineSpans[i + 1])
+      continue;
+    spans.push_back(lineSpans[i]);
+    spans.push_back(lineSpans[i + 1]);
+    next.push_back(none);
+    prev.push_back(none);
+    joined.push_back(0);
+  }
+  lines.push_back(spans.size() / 2);
+
+  size_t numOfLines = GetNumOfLines();
+  if (numOfLines < 2)
+    return;
+  size_t
+    prevBegin = lines[numOfLines - 2], prevEnd = lines[numOfLines - 1],
+    curBegin = prevEnd, curEnd = lines[numOfLines];
+
+  // spans of each line are sorted and do not intersect, so overlapping pairs are found by merge
+  for (size_t i = prevBegin, j = curBegin; i < prevEnd && j < curEnd; ) {
+    if (spans[2 * i + 1] < spans[2 * j])
+      i++;
+    else if (spans[2 * j + 1] < spans[2 * i])
+      j++;
+    else {
+      Overlap(&next[i], j);
+      Overlap(&prev[j], i);
+      if (spans[2 * i + 1] < spans[2 * j + 1])
+        i++;
+      else
+        j++;
+    }
+  }
+
+  // cell splits or merges where span overlaps several ones, so only one-to-one overlaps are kept
+  for (size_t i = prevBegin; i < prevEnd; i++)
+    if (next[i] == several || (next[i] != none && prev[next[i]] != i))
+      next[i] = none;
+  for (size_t j = curBegin; j < curEnd; j++)
+    if (prev[j] == several || (prev[j] != none && next[prev[j]] != j))
+      prev[j] = none;
+}
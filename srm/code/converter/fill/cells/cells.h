@@ -0,0 +1,78 @@
+/**
+ * @file
+ * @brief Boustrophedon cells of hatch lines class header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains cells_t class description to decompose hatch spans of region into monotone cells
+ */
+
+#pragma once
+
+#ifndef __CELLS_H_INCLUDED
+#define __CELLS_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * @brief Boustrophedon cells of hatch lines class
+   *
+   * Spans of hatch lines are added line by line. Span is linked to span of the next line if they overlap
+   * each other only, so linked spans form cells monotone across hatch lines where the number of spans
+   * does not change. Cells are painted by zigzags, so adjacent spans of cell may be joined without departure.
+   * Buffers are kept between regions, so filling does not allocate in steady state
+   */
+  class cells_t {
+  public:
+    static constexpr size_t none = (size_t)-1;  ///< index of absent span
+
+    std::vector<double> spans;     ///< ends of spans of all lines (span i is [spans[2 * i], spans[2 * i + 1]])
+    std::vector<size_t> lines;     ///< index of the first span of each line (and total number of spans at the end)
+    std::vector<size_t>
+      next,                        ///< index of linked span of the next line (none at the end of cell)
+      prev;                        ///< index of linked span of the previous line (none at the start of cell)
+    std::vector<uint8_t> joined;   ///< 1 if span is joined with the next span of cell without departure
+
+  private:
+    static constexpr size_t several = (size_t)-2;  ///< mark of span overlapping several spans
+
+    /**
+     * Mark overlapping of 2 spans function
+     * @param[in, out] link link of span to mark
+     * @param[in] span index of overlapping span
+     */
+    static void Overlap(size_t *link, size_t span) noexcept;
+
+  public:
+    /**
+     * Constructor for cells_t
+     */
+    cells_t(void);
+
+    /**
+     * Remove all lines keeping capacity function
+     */
+    void Clear(void) noexcept;
+
+    /**
+     * Get number of lines function
+     * @return number of lines
+     */
+    size_t GetNumOfLines(void) const noexcept {
+      return lines.size() - 1;
+    }
+
+    /**
+     * Add spans of the next line and link them to spans of the previous line function
+     * @param[in] lineSpans ends of spans of line in increasing order (span i is [res[2 * i], res[2 * i + 1]]),
+     *                      empty spans are skipped
+     */
+    void AddLine(const std::vector<double> &lineSpans);
+  };
+}
+
+#endif /* __CELLS_H_INCLUDED */
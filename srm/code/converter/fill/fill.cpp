@@ -11,32 +11,30 @@
 
 #include <algorithm>
 #include <sstream>
+#include <thread>
+#include <utility>
 
  /**
   * Principal component analysis
-  * @param[in] primitive for filling
+  * @param[in] geom geometry with region for filling
+  * @param[in] begin index of the first primitive of region
+  * @param[in] end index after the last primitive of region
+  * @param[in] x, y robot coordinates of region points (from the first point of region)
   * @return pair of the first and second principal components vectors
   */
-static std::pair<srm::vec_t, srm::vec_t> _PCA(const srm::primitive_t &primitive)  noexcept {
-  const double eps = 1e-4; // defines when primitive is considered closed
-  bool isClosed = true;
-
-  size_t size = primitive.size();
-  if ((primitive[primitive.size() - 1].point - primitive.start).Len() > eps) {
-    isClosed = false;
-    ++size;
-  }
-
-  double ex, ey; // expected value of x and y
-  ex = 0;
-  ey = 0;
-  for (const auto &segment : primitive) {
-    ex += segment.point.x;
-    ey += segment.point.y;
-  }
-  if (!isClosed) {
-    ex += primitive.start.x;
-    ey += primitive.start.y;
+static std::pair<srm::vec_t, srm::vec_t> _PCA(const srm::geometry_t &geom, size_t begin, size_t end,
+  const double *x, const double *y) noexcept {
+  size_t base = geom.Begin(begin), size = 0;
+
+  // the last point of closed contour repeats the first one, so the first one is skipped
+  double ex = 0, ey = 0; // expected value of x and y
+  for (size_t prim = begin; prim < end; prim++) {
+    size_t first = geom.Begin(prim) - base + ((geom.flags[prim] & srm::geometry_t::closed) ? 1 : 0);
+    for (size_t i = first; i < geom.End(prim) - base; i++) {
+      ex += x[i];
+      ey += y[i];
+      size++;
+    }
   }
   ex /= size;
   ey /= size;
@@ -46,19 +44,15 @@ static std::pair<srm::vec_t, srm::vec_t> _PCA(const srm::primitive_t &primitive)
          cov11 = 0; // symmetric covariance matrix
 
   double dx, dy;
-  for (const auto &segment : primitive) {
-    dx = segment.point.x - ex;
-    dy = segment.point.y - ey;
-    cov00 += dx * dx;
-    cov01 += dx * dy;
-    cov11 += dy * dy;
-  }
-  if (!isClosed) {
-    dx = primitive.start.x - ex;
-    dy = primitive.start.y - ey;
-    cov00 += dx * dx;
-    cov01 += dx * dy;
-    cov11 += dy * dy;
+  for (size_t prim = begin; prim < end; prim++) {
+    size_t first = geom.Begin(prim) - base + ((geom.flags[prim] & srm::geometry_t::closed) ? 1 : 0);
+    for (size_t i = first; i < geom.End(prim) - base; i++) {
+      dx = x[i] - ex;
+      dy = y[i] - ey;
+      cov00 += dx * dx;
+      cov01 += dx * dy;
+      cov11 += dy * dy;
+    }
   }
   cov00 /= size;
   cov01 /= size;
@@ -90,159 +84,448 @@ static std::pair<srm::vec_t, srm::vec_t> _PCA(const srm::primitive_t &primitive)
 }
 
 /**
- * Get list of primitive's segments
- * @param[out] primitive primitive
- * @param[out] segments list of primitive's segments
+ * Print code for moving to point in contact
+ * @param[in] out output stream
+ * @param[in] p robot coordinates of point
  */
-static void _getSegmentsList(const srm::primitive_t &primitive, 
-  std::list<std::pair<srm::vec_t, srm::vec_t>> *segments) {
+static void _writeMove(std::ostream &out, srm::vec_t p) {
+  out << "\tLMOVE frm + SHIFT (P BY " +
+    std::to_string(p.x) + ", " +
+    std::to_string(p.y) + ", 0)\n";
+}
 
-  segments->clear();
+/**
+ * Print code for approaching to point
+ * @param[in] roboConf robot configuration
+ * @param[in] out output stream
+ * @param[in] p robot coordinates of point
+ */
+static void _writeApproach(const srm::robot_conf_t &roboConf, std::ostream &out, srm::vec_t p) {
+  out << "\tLAPPRO frm + SHIFT (P BY " +
+    std::to_string(p.x) + ", " +
+    std::to_string(p.y) + ", 0), " << std::to_string(roboConf.GetDepDist()) << "\n";
+  _writeMove(out, p);
+}
 
-  const double eps = 1e-4; // defines when primitive is considered closed
-  
-  segments->push_back(std::pair{primitive.start, primitive[0].point});
-  for (int i = 0; i < (int)primitive.size() - 1; ++i) 
-    segments->push_back(std::pair{ primitive[i].point, primitive[i + 1].point });
+/**
+ * Print code for departure
+ * @param[in] roboConf robot configuration
+ * @param[in] out output stream
+ */
+static void _writeDepart(const srm::robot_conf_t &roboConf, std::ostream &out) {
+  out << "\tLDEPART " << std::to_string(roboConf.GetDepDist()) << "\n";
+}
 
-  if ((primitive[primitive.size() - 1].point - primitive.start).Len() > eps) // is not closed
-    segments->push_back(std::pair{ primitive[primitive.size() - 1].point, primitive.start });
+/**
+ * Print code for filling one span of scanline
+ * @param[in] roboConf robot configuration
+ * @param[in] out output stream
+ * @param[in] start robot coordinates of span start
+ * @param[in] end robot coordinates of span end
+ */
+static void _writeCode(const srm::robot_conf_t &roboConf, std::ostream &out, srm::vec_t start, srm::vec_t end) {
+  _writeApproach(roboConf, out, start);
+  _writeMove(out, end);
+  _writeDepart(roboConf, out);
+}
+
+/**
+ * @brief Hatch lines of region in hatch basis
+ */
+struct hatch_t {
+  const srm::scanline_t *scanline;  ///< sorted edge table of region
+  srm::scanline_t::rule_t rule;     ///< rule of region interior
+  srm::vec_t e1, e2;                ///< robot coordinates of u and v axes
+  double vMin;                      ///< v of the first hatch line
+  double step;                      ///< distance between hatch lines
+};
+
+/**
+ * Print code for filling band of hatch lines
+ * @param[in] roboConf robot configuration
+ * @param[in] out output stream
+ * @param[in] hatch hatch lines of region
+ * @param[in, out] cursor cursor of band
+ * @param[in] first index of the first hatch line of band
+ * @param[in] last index after the last hatch line of band
+ * @return number of written fill segments
+ */
+static size_t _fillBand(const srm::robot_conf_t &roboConf, std::ostream &out, const hatch_t &hatch,
+  srm::scanline_t::cursor_t *cursor, size_t first, size_t last) {
+  size_t numOfSegments = 0;
+  hatch.scanline->Start(cursor);
+  for (size_t line = first; line < last; line++) {
+    // line position and direction depend only on line index, so bands give the same lines as serial hatching
+    double v = hatch.vMin + line * hatch.step;
+    bool directionFlag = line % 2 == 1;
+    const std::vector<double> &spans = hatch.scanline->GetSpans(cursor, v, hatch.rule);
+    size_t numOfSpans = spans.size() / 2;
+    for (size_t k = 0; k < numOfSpans; k++) {
+      // odd lines go along u, even lines - back
+      size_t i = directionFlag ? 2 * k : 2 * (numOfSpans - 1 - k);
+      double u1 = spans[i], u2 = spans[i + 1];
+      if (u1 == u2)
+        continue;
+      if (!directionFlag)
+        std::swap(u1, u2);
+      _writeCode(roboConf, out, hatch.e1 * u1 + hatch.e2 * v, hatch.e1 * u2 + hatch.e2 * v);
+      numOfSegments++;
+    }
+  }
+  return numOfSegments;
+}
 
+/**
+ * Get ends of span of cell on hatch line function. Directions of hatch lines alternate like in _fillBand
+ * @param[in] cells cells of hatch lines
+ * @param[in] span index of span
+ * @param[in] line index of hatch line of span
+ * @return u of start and end of span
+ */
+static std::pair<double, double> _getSpanEnds(const srm::cells_t &cells, size_t span, size_t line) noexcept {
+  double u1 = cells.spans[2 * span], u2 = cells.spans[2 * span + 1];
+  return line % 2 == 1 ? std::pair(u1, u2) : std::pair(u2, u1);
 }
 
 /**
- * Find intersection points of line with primitive's segments
- * @param[in] h height of line along the axis e2
- * @param[in] e1 the first basis vector
- * @param[in] e2 the second basis vector
- * @param[in] segments list of primitive's segments
- * @param[out] interPoints intersection points of line with primitive's segments
+ * Print code for filling region by boustrophedon cells. Each cell is painted by zigzag of its spans, adjacent spans
+ * are joined in contact if the joining move lies in region
+ * @param[in, out] ctx conversion context (its scratch buffers are used)
+ * @param[in] out output stream
+ * @param[in] hatch hatch lines of region
+ * @param[in] numOfLines number of hatch lines
+ * @return number of written fill segments (including joining moves)
  */
-static void _getIntersectionPoints(double h, srm::vec_t e1, srm::vec_t e2, 
-  std::list<std::pair<srm::vec_t, srm::vec_t>> *segments, 
-  std::list<srm::vec_t> *interPoints) noexcept {
-
-  interPoints->clear();
-
-  auto it = segments->begin();
-  double A1, B1, C1; // line equation coefs Ax + By + C = 0 for painting line
-  double A2, B2, C2; // line equation coefs Ax + By + C = 0 for line includes segment
-  double x, y; // intersection coords
-  double det; // determinant
-  const double eps = 1e-8; // 0 with error
-  A1 = e2.x;
-  B1 = e2.y;
-  while (it != segments->end() && std::min(it->first.Dot(e2), it->second.Dot(e2)) < h) {
-    if (std::max(it->first.Dot(e2), it->second.Dot(e2)) < h) {
-      auto tmp = ++it;
-      --it;
-      segments->erase(it);
-      it = tmp;
+static size_t _fillCells(srm::conversion_context_t *ctx, std::ostream &out, const hatch_t &hatch,
+  size_t numOfLines) {
+  const srm::robot_conf_t &roboConf = ctx->roboConf;
+  srm::cells_t &cells = ctx->fillCells;
+  srm::scanline_t::cursor_t &cursor = ctx->fillCursors[0], &links = ctx->fillCursors[1];
+  auto getPoint = [&](double u, size_t line) {
+    return hatch.e1 * u + hatch.e2 * (hatch.vMin + line * hatch.step);
+  };
+
+  // links of spans of line are checked when spans of the next line are known
+  cells.Clear();
+  hatch.scanline->Start(&cursor);
+  hatch.scanline->Start(&links);
+  for (size_t line = 0; line < numOfLines; line++) {
+    cells.AddLine(hatch.scanline->GetSpans(&cursor, hatch.vMin + line * hatch.step, hatch.rule));
+    if (line == 0)
       continue;
+    for (size_t span = cells.lines[line - 1]; span < cells.lines[line]; span++) {
+      if (cells.next[span] == srm::cells_t::none)
+        continue;
+      double
+        end = _getSpanEnds(cells, span, line - 1).second,
+        start = _getSpanEnds(cells, cells.next[span], line).first;
+      cells.joined[span] = hatch.scanline->IsLinkInside(&links,
+        srm::vec_t(end, hatch.vMin + (line - 1) * hatch.step), srm::vec_t(start, hatch.vMin + line * hatch.step),
+        hatch.rule);
     }
-    C1 = -h;
-    A2 = it->second.y - it->first.y;
-    B2 = it->first.x - it->second.x;
-    C2 = it->first.y * it->second.x - it->first.x * it->second.y;
-    det = A1 * B2 - A2 * B1;
-    if (fabs(det) > eps) {
-      x = (-C1 * B2 + C2 * B1) / det;
-      y = (-A1 * C2 + A2 * C1) / det;
-      if (x >= std::min(it->first.x, it->second.x) - eps && x <= std::max(it->first.x, it->second.x + eps)
-        && y >= std::min(it->first.y, it->second.y) - eps && y <= std::max(it->first.y, it->second.y) + eps) {
-        interPoints->push_back(srm::vec_t(x, y));
+  }
+
+  // cells are painted in order of their first spans
+  size_t numOfSegments = 0;
+  for (size_t line = 0; line < numOfLines; line++)
+    for (size_t first = cells.lines[line]; first < cells.lines[line + 1]; first++) {
+      if (cells.prev[first] != srm::cells_t::none)
+        continue;
+      auto ends = _getSpanEnds(cells, first, line);
+      _writeApproach(roboConf, out, getPoint(ends.first, line));
+      _writeMove(out, getPoint(ends.second, line));
+      numOfSegments++;
+      for (size_t span = first, spanLine = line; cells.next[span] != srm::cells_t::none; spanLine++) {
+        bool isJoined = cells.joined[span] != 0;
+        span = cells.next[span];
+        ends = _getSpanEnds(cells, span, spanLine + 1);
+        if (isJoined) {
+          _writeMove(out, getPoint(ends.first, spanLine + 1));
+          numOfSegments++;
+          ctx->stats.savedDeparts++;
+        }
+        else {
+          _writeDepart(roboConf, out);
+          _writeApproach(roboConf, out, getPoint(ends.first, spanLine + 1));
+        }
+        _writeMove(out, getPoint(ends.second, spanLine + 1));
+        numOfSegments++;
       }
+      _writeDepart(roboConf, out);
     }
-    ++it;
-  }
+  return numOfSegments;
 }
 
 /**
- * Print code for filling primitive in one line
+ * Print code for filling region by offset contours. Each contour is painted as closed loop from its point
+ * nearest to the current position, contour of the next level is joined to it in contact if the joining move
+ * lies in region, so nested contours are painted by spiral
+ * @param[in, out] ctx conversion context (its scratch buffers are used)
  * @param[in] out output stream
- * @param[in] interPoints intersection points of line with primitive's segments
+ * @param[in] hatch hatch lines of region (sets basis and step)
+ * @param[in] bboxMin, bboxMax bounding box of region in (u, v)
+ * @param[in] maxCells maximal number of raster cells of distances
+ * @return number of written fill segments (including joining moves)
  */
-static void _writeCode(std::ostream &out, const std::list<srm::vec_t> &interPoints) noexcept {
-  auto it1 = interPoints.begin();
-  auto tmp = it1;
-  auto it2 = it1;
-
-  srm::translator_t* trans = srm::translator_t::GetPtr();
-  while (it1 != interPoints.end()) {
-    tmp = it1;
-    it2 = ++it1;
-    it1 = tmp;
-
-    double scaleX = trans->roboConf.GetXScale();
-    double scaleY = trans->roboConf.GetYScale();
-    out << "\tLAPPRO frm + SHIFT (P BY " +
-      std::to_string(it1->x * scaleX) + ", " +
-      std::to_string(it1->y * scaleY) + ", 0), " << std::to_string(trans->roboConf.GetDepDist()) << "\n";
-
-    out << "\tLMOVE frm + SHIFT (P BY " +
-      std::to_string(it1->x * scaleX) + ", " +
-      std::to_string(it1->y * scaleY) + ", 0)\n";
-
-    out << "\tLMOVE frm + SHIFT (P BY " +
-      std::to_string(it2->x * scaleX) + ", " +
-      std::to_string(it2->y * scaleY) + ", 0)\n";
-
-
-    out << "\tLDEPART " << std::to_string(trans->roboConf.GetDepDist()) << "\n";
+static size_t _fillOffsets(srm::conversion_context_t *ctx, std::ostream &out, const hatch_t &hatch,
+  srm::vec_t bboxMin, srm::vec_t bboxMax, size_t maxCells) {
+  // contour of the next level is about step away, farther contours are not joined
+  const double maxJoinDist = 2 * hatch.step;
+  const srm::robot_conf_t &roboConf = ctx->roboConf;
+  srm::offset_fill_t &offsets = ctx->fillOffsets;
+  offsets.Build(*hatch.scanline, &ctx->fillCursors[0], hatch.rule, bboxMin, bboxMax, hatch.step, maxCells);
+  auto getPoint = [&](size_t i) {
+    return hatch.e1 * offsets.u[i] + hatch.e2 * offsets.v[i];
+  };
+  auto getNearest = [&](size_t loop, srm::vec_t p) {
+    size_t nearest = offsets.loops[loop];
+    for (size_t i = nearest + 1; i < offsets.loops[loop + 1]; i++)
+      if ((srm::vec_t(offsets.u[i], offsets.v[i]) - p).Len2() <
+        (srm::vec_t(offsets.u[nearest], offsets.v[nearest]) - p).Len2())
+        nearest = i;
+    return nearest;
+  };
+
+  size_t numOfLoops = offsets.GetNumOfLoops(), numOfSegments = 0;
+  std::vector<uint8_t> isPainted(numOfLoops, 0);
+  srm::vec_t pos;
+  size_t loop = (size_t)-1, start = 0;
+  for (size_t numOfPainted = 0; numOfPainted < numOfLoops; numOfPainted++) {
+    // contour of the next level nearest to the end of the previous one is joined in contact
+    size_t next = (size_t)-1, nextStart = 0;
+    if (loop != (size_t)-1) {
+      double bestDist = maxJoinDist;
+      for (size_t i = 0; i < numOfLoops; i++) {
+        if (isPainted[i] || offsets.levels[i] != offsets.levels[loop] + 1)
+          continue;
+        size_t nearest = getNearest(i, pos);
+        double d = (srm::vec_t(offsets.u[nearest], offsets.v[nearest]) - pos).Len();
+        if (d < bestDist && offsets.IsInside(pos, srm::vec_t(offsets.u[nearest], offsets.v[nearest]))) {
+          bestDist = d;
+          next = i;
+          nextStart = nearest;
+        }
+      }
+    }
+    if (next != (size_t)-1) {
+      _writeMove(out, getPoint(nextStart));
+      numOfSegments++;
+      ctx->stats.savedDeparts++;
+    }
+    else {
+      // spiral is ended, the outermost contour not painted yet starts the next one
+      for (size_t i = 0; i < numOfLoops; i++)
+        if (!isPainted[i] && (next == (size_t)-1 || offsets.levels[i] < offsets.levels[next]))
+          next = i;
+      nextStart = loop == (size_t)-1 ? offsets.loops[next] : getNearest(next, pos);
+      if (loop != (size_t)-1)
+        _writeDepart(roboConf, out);
+      _writeApproach(roboConf, out, getPoint(nextStart));
+    }
 
-    ++it1;
-    ++it1;
+    loop = next;
+    start = nextStart;
+    isPainted[loop] = 1;
+    size_t first = offsets.loops[loop], last = offsets.loops[loop + 1];
+    for (size_t i = start + 1; i < last; i++)
+      _writeMove(out, getPoint(i));
+    for (size_t i = first; i <= start; i++)
+      _writeMove(out, getPoint(i));
+    numOfSegments += last - first;
+    pos = srm::vec_t(offsets.u[start], offsets.v[start]);
   }
+  if (loop != (size_t)-1)
+    _writeDepart(roboConf, out);
+  return numOfSegments;
 }
 
 /**
-  * Gen and print code for filling primitive
-  * @param[in] out output stream
-  * @param[in] primitive for filling
-  */
-void srm::FillPrimitive(std::ostream &out, const srm::primitive_t &primitive) noexcept {
-  auto basis =_PCA(primitive);
-  vec_t e1 = basis.first;
-  vec_t e2 = basis.second;
-
-  std::list<std::pair<vec_t, vec_t>> segments;
-  _getSegmentsList(primitive, &segments);
-  segments.sort([e2](const std::pair<vec_t, vec_t>& lhs, const std::pair<vec_t, vec_t>& rhs) -> bool {
-    return std::min(lhs.first.Dot(e2), lhs.second.Dot(e2)) < std::min(rhs.first.Dot(e2), rhs.second.Dot(e2));
-    });
-
-  double y = std::min(segments.front().first.Dot(e2), segments.front().second.Dot(e2));
-  double finish = -1e60;
-  double tmp;
-  for (const auto &segment : segments) {
-    tmp = std::max(segment.first.Dot(e2), segment.second.Dot(e2));
-    if (tmp > finish)
-      finish = tmp;
-  }
+ * Get angle of hatch direction function. Opposite directions give the same hatch lines
+ * @param[in] dir direction
+ * @return angle in degrees in [0, 180)
+ */
+static double _getHatchAngle(srm::vec_t dir) noexcept {
+  // atan2 gives angle in [-180, 180], it is shifted to positive values before reduction
+  return fmod(atan2(dir.y, dir.x) * 180 / srm::pi + 360, 180);
+}
 
-  translator_t *trans = translator_t::GetPtr();
-  // TODO: step from robot to svg
-  std::list<vec_t> interPoints;
-  double step = trans->roboConf.GetPouringStep();
-  bool directionFlag = false;
-  while (y < finish) {
-    _getIntersectionPoints(y, e1, e2, &segments, &interPoints);
-    if (directionFlag) {
-      interPoints.sort([e1](const vec_t& lhs, const vec_t& rhs) {
-        return lhs.Dot(e1) < rhs.Dot(e1);
-        });
+/**
+ * Gen and print code for filling region. Region is hatched in robot coordinates with pouring step along
+ * the direction of the least estimated robot time (principal axis of region or one of uniform angles),
+ * directions of hatch lines alternate. Big regions are splitted to bands of hatch lines
+ * hatched by context fill threads, code of bands is written in order, so it is the same as serial one.
+ * In boustrophedon hatching mode region is painted along its principal axis by zigzags of monotone cells
+ * without departures between adjacent lines where possible, in offset mode - by spirals of contours offset inside by step
+ * (regions too big to resolve contours by raster of distances are hatched by lines with warning)
+ * @param[in, out] ctx conversion context (its scratch buffers are used)
+ * @param[in] out output stream
+ * @param[in] geom geometry with region for filling
+ * @param[in] begin index of the first primitive (contour) of region
+ * @param[in] end index after the last primitive (contour) of region
+ * @return number of written fill segments
+ */
+size_t srm::FillRegion(conversion_context_t *ctx, std::ostream &out, const srm::geometry_t &geom, size_t begin,
+  size_t end) {
+  // bands are not shorter than this, so thread start is negligible against band hatching
+  const size_t minLinesPerBand = 256;
+  // raster of distances is bounded by 2M cells (48 MB with edge links)
+  const size_t maxOffsetCells = 1 << 21;
+  double step = ctx->roboConf.GetPouringStep();
+  if (begin >= end || step <= 0)
+    return 0;
+
+  // points of all contours are contiguous, they are mapped to robot coordinates at once
+  size_t base = geom.Begin(begin), n = geom.End(end - 1) - base;
+  std::vector<double> &buf = ctx->codeBuf;
+  buf.resize(2 * n);
+  double *x = buf.data(), *y = buf.data() + n;
+  kernels::Scale(ctx->roboConf.GetXScale(), ctx->roboConf.GetYScale(), geom.x.data() + base, geom.y.data() + base,
+    x, y, n);
+
+  auto basis = _PCA(geom, begin, end, x, y);
+  hatch_t hatch;
+  hatch.e1 = basis.first;
+  hatch.e2 = basis.second;
+  hatch.rule =
+    (geom.flags[begin] & geometry_t::evenOdd) ? scanline_t::rule_t::evenOdd : scanline_t::rule_t::nonZero;
+
+  // offset contours one step apart are not resolved by raster coarser than half step,
+  // so such region is hatched by lines
+  uint8_t flags = geom.flags[begin];
+  if (flags & geometry_t::offset) {
+    vec_t bboxMin(1e60, 1e60), bboxMax(-1e60, -1e60);
+    for (size_t i = 0; i < n; i++) {
+      vec_t p(x[i], y[i]), q(p.Dot(hatch.e1), p.Dot(hatch.e2));
+      bboxMin = vec_t(std::min(bboxMin.x, q.x), std::min(bboxMin.y, q.y));
+      bboxMax = vec_t(std::max(bboxMax.x, q.x), std::max(bboxMax.y, q.y));
     }
-    else {
-      interPoints.sort([e1](const vec_t& lhs, const vec_t& rhs) {
-        return lhs.Dot(e1) > rhs.Dot(e1);
-        });
+    double cell = offset_fill_t::GetCellSize(bboxMax - bboxMin, step, maxOffsetCells);
+    if (cell > step / 2) {
+      std::ostringstream log;
+      log << "Warning: fill region is too big for offset contours with step " << step << " (raster cell " <<
+        cell << "), it is hatched by lines";
+      ctx->WriteLog(log.str());
+      flags &= (uint8_t)~(geometry_t::offset | geometry_t::boustrophedon);
     }
+  }
+
+  // hatch lines go along the cheapest direction by estimated robot time; boustrophedon cells are joined in contact
+  // and offset contours do not depend on direction, so they are kept along principal axis.
+  // Principal axis is kept if gain is within accuracy of estimation
+  const double minGain = 0.01;
+  if (!(flags & (geometry_t::boustrophedon | geometry_t::offset))) {
+    auto costs = ctx->hatchAngle.Choose(ctx->roboConf, geom, begin, end, x, y, hatch.rule, hatch.e1,
+      ctx->numOfFillThreads);
+    if (costs.first.time < costs.second.time * (1 - minGain)) {
+      hatch.e1 = costs.first.dir;
+      hatch.e2 = vec_t(-hatch.e1.y, hatch.e1.x);
+      double
+        angle = _getHatchAngle(hatch.e1),
+        principal = _getHatchAngle(basis.first),
+        saved = costs.second.time - costs.first.time;
+      ctx->stats.fillTimeSaved += saved;
+      std::ostringstream log;
+      log << "Fill region: hatch angle " << angle << " deg instead of principal axis " << principal <<
+        " deg, estimated time " << costs.first.time << " s instead of " << costs.second.time << " s (-" <<
+        saved * 100 / costs.second.time << "%), segments " << costs.first.numOfSegments << " instead of " <<
+        costs.second.numOfSegments;
+      ctx->WriteLog(log.str());
+    }
+  }
 
-    _writeCode(out, interPoints);
+  // points are replaced by their coordinates in hatch basis: u along hatch lines, v across them
+  double uMin = 1e60, uMax = -1e60, vMin = 1e60, vMax = -1e60;
+  for (size_t i = 0; i < n; i++) {
+    vec_t p(x[i], y[i]);
+    x[i] = p.Dot(hatch.e1);
+    y[i] = p.Dot(hatch.e2);
+    uMin = std::min(uMin, x[i]);
+    uMax = std::max(uMax, x[i]);
+    vMin = std::min(vMin, y[i]);
+    vMax = std::max(vMax, y[i]);
+  }
+
+  scanline_t &scanline = ctx->scanline;
+  scanline.Clear();
+  for (size_t prim = begin; prim < end; prim++) {
+    size_t first = geom.Begin(prim) - base;
+    scanline.AddContour(x + first, y + first, geom.End(prim) - geom.Begin(prim));
+  }
+  scanline.Sort();
+  hatch.scanline = &scanline;
+  hatch.vMin = vMin;
+  hatch.step = step;
+
+  size_t
+    numOfLines = vMax > vMin ? (size_t)ceil((vMax - vMin) / step) : 0,
+    numOfBands = std::max<size_t>(1, std::min<size_t>(ctx->numOfFillThreads, numOfLines / minLinesPerBand));
+  std::vector<scanline_t::cursor_t> &cursors = ctx->fillCursors;
+  // boustrophedon cells are linked through all lines, so they are built serially by lines and links cursors,
+  // offset contours are traced serially too
+  if (flags & (geometry_t::boustrophedon | geometry_t::offset)) {
+    if (cursors.size() < 2)
+      cursors.resize(2);
+    if (flags & geometry_t::offset)
+      return _fillOffsets(ctx, out, hatch, vec_t(uMin, vMin), vec_t(uMax, vMax), maxOffsetCells);
+    return _fillCells(ctx, out, hatch, numOfLines);
+  }
+  if (cursors.size() < numOfBands)
+    cursors.resize(numOfBands);
+  if (numOfBands == 1)
+    return _fillBand(ctx->roboConf, out, hatch, &cursors[0], 0, numOfLines);
+
+  // the first band is hatched by the calling thread, all bands write to their own buffers
+  std::vector<std::ostringstream> bandsOut(numOfBands);
+  std::vector<size_t> bandsSegments(numOfBands);
+  auto fillBand = [&](size_t band) {
+    bandsSegments[band] = _fillBand(ctx->roboConf, bandsOut[band], hatch, &cursors[band],
+      numOfLines * band / numOfBands, numOfLines * (band + 1) / numOfBands);
+  };
+  std::vector<std::thread> workers;
+  for (size_t band = 1; band < numOfBands; band++)
+    workers.emplace_back(fillBand, band);
+  fillBand(0);
+  for (auto &worker : workers)
+    worker.join();
+
+  size_t numOfSegments = 0;
+  for (size_t band = 0; band < numOfBands; band++) {
+    out << bandsOut[band].str();
+    numOfSegments += bandsSegments[band];
+  }
+  return numOfSegments;
+}
 
-    directionFlag = directionFlag ? false : true;
+/**
+ * Get fill rule of tag function
+ * @param[in] tag tag for checking
+ * @return true if tag is filled by even-odd rule, false - if by nonzero rule
+ */
+bool srm::IsEvenOdd(const rapidxml::xml_node<>* tag) noexcept {
+  auto attr = tag->last_attribute("fill-rule");
+  return attr != nullptr && std::string(attr->value(), attr->value_size()) == "evenodd";
+}
 
-    y += step;
+/**
+ * Get flags of primitives of tag function
+ * @param[in] roboConf robot configuration (sets hatching modes)
+ * @param[in] tag tag for checking
+ * @return fill flags of geometry_t (0 if tag is not filled)
+ */
+uint8_t srm::GetFillFlags(const robot_conf_t &roboConf, const rapidxml::xml_node<>* tag) {
+  if (!IsFill(tag))
+    return 0;
+  uint8_t flags = IsEvenOdd(tag) ? geometry_t::fill | geometry_t::evenOdd : geometry_t::fill;
+
+  auto id = tag->last_attribute("id"), classes = tag->last_attribute("class");
+  switch (roboConf.GetHatching(id != nullptr ? std::string(id->value(), id->value_size()) : std::string(),
+    classes != nullptr ? std::string(classes->value(), classes->value_size()) : std::string())) {
+  case hatching_t::boustrophedon:
+    return flags | geometry_t::boustrophedon;
+  case hatching_t::offset:
+    return flags | geometry_t::offset;
+  default:
+    return flags;
   }
 }
 
@@ -26,11 +26,35 @@ namespace srm {
   bool IsFill(const rapidxml::xml_node<>* tag) noexcept;
 
   /**
-   * Gen and print code for filling primitive
+   * Get fill rule of tag function
+   * @param[in] tag tag for checking
+   * @return true if tag is filled by even-odd rule, false - if by nonzero rule
+   */
+  bool IsEvenOdd(const rapidxml::xml_node<>* tag) noexcept;
+
+  /**
+   * Get flags of primitives of tag function
+   * @param[in] roboConf robot configuration (sets hatching modes)
+   * @param[in] tag tag for checking
+   * @return fill flags of geometry_t (0 if tag is not filled)
+   */
+  uint8_t GetFillFlags(const robot_conf_t &roboConf, const rapidxml::xml_node<>* tag);
+
+  /**
+   * Gen and print code for filling region. Region is hatched in robot coordinates along its principal axis
+   * with pouring step, directions of hatch lines alternate. Big regions are splitted to bands of hatch lines
+   * hatched by context fill threads, code of bands is written in order, so it is the same as serial one.
+   * In boustrophedon hatching mode region is painted by zigzags of monotone cells without departures
+   * between adjacent lines where possible, in offset mode - by spirals of contours offset inside by step
+   * @param[in, out] ctx conversion context (its scratch buffers are used)
    * @param[in] out output stream
-   * @param[in] primitive for filling
+   * @param[in] geom geometry with region for filling
+   * @param[in] begin index of the first primitive (contour) of region
+   * @param[in] end index after the last primitive (contour) of region
+   * @return number of written fill segments
    */
-  void FillPrimitive(std::ostream &out, const srm::primitive_t &primitive) noexcept;
+  size_t FillRegion(conversion_context_t *ctx, std::ostream &out, const srm::geometry_t &geom, size_t begin,
+    size_t end);
 }
 
 #endif /* __FILL_H_INCLUDED */
@@ -0,0 +1,296 @@
+/**
+ * @file
+ * @brief Offset contours of region class source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains offset_fill_t class realisation to build contours of region offset inside by fill step
+ */
+
+#include <srm.h>
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * Distance transform of row or column function (lower envelope of parabolas)
+ * @param[in, out] values squared distances of row or column
+ * @param[in] n number of values
+ * @param[in] stride distance between values in array
+ */
+void srm::offset_fill_t::Transform(double *values, size_t n, size_t stride) {
+  const double inf = std::numeric_limits<double>::infinity();
+  envelope.resize(n);
+  bounds.resize(n + 1);
+  parabolas.resize(n);
+  for (size_t i = 0; i < n; i++)
+    envelope[i] = values[i * stride];
+
+  // parabola of each value is kept while it is lower than the previous ones somewhere
+  size_t k = 0;
+  parabolas[0] = 0;
+  bounds[0] = -inf;
+  bounds[1] = inf;
+  for (size_t q = 1; q < n; q++) {
+    auto getCross = [&](size_t p) {
+      return (envelope[q] + (double)q * q - envelope[p] - (double)p * p) / (2.0 * q - 2.0 * p);
+    };
+    double s = getCross(parabolas[k]);
+    while (s <= bounds[k])
+      s = getCross(parabolas[--k]);
+    parabolas[++k] = q;
+    bounds[k] = s;
+    bounds[k + 1] = inf;
+  }
+
+  k = 0;
+  for (size_t q = 0; q < n; q++) {
+    while (bounds[k + 1] < q)
+      k++;
+    double d = (double)q - (double)parabolas[k];
+    values[q * stride] = d * d + envelope[parabolas[k]];
+  }
+}
+
+/**
+ * Get point of contour on raster edge function
+ * @param[in] edge index of edge
+ * @param[in] value distance of level
+ * @return u and v of point
+ */
+srm::vec_t srm::offset_fill_t::GetEdgePoint(uint32_t edge, double value) const noexcept {
+  // horizontal edges go first, then vertical ones
+  size_t node = edge < width * height ? edge : edge - width * height;
+  size_t other = edge < width * height ? node + 1 : node + width;
+  double t = (value - dist[node]) / (dist[other] - dist[node]);
+  vec_t
+    p1((node % width - 0.5) * cell + uMin, (node / width - 0.5) * cell + vMin),
+    p2((other % width - 0.5) * cell + uMin, (other / width - 0.5) * cell + vMin);
+  return p1 + (p2 - p1) * t;
+}
+
+/**
+ * Get distance to border in point by bilinear interpolation function
+ * @param[in] p u and v of point
+ * @return distance to border (negative outside)
+ */
+double srm::offset_fill_t::GetDist(vec_t p) const noexcept {
+  double
+    fu = std::clamp((p.x - uMin) / cell + 0.5, 0.0, width - 1.0),
+    fv = std::clamp((p.y - vMin) / cell + 0.5, 0.0, height - 1.0);
+  size_t
+    i = std::min((size_t)fu, width - 2),
+    j = std::min((size_t)fv, height - 2);
+  double tu = fu - i, tv = fv - j;
+  const double *d = dist.data() + j * width + i;
+  return (d[0] * (1 - tu) + d[1] * tu) * (1 - tv) + (d[width] * (1 - tu) + d[width + 1] * tu) * tv;
+}
+
+/**
+ * Simplify the last contour function
+ * @param[in] tolerance maximal distance of removed points to simplified contour
+ */
+void srm::offset_fill_t::SimplifyLoop(double tolerance) {
+  // marching squares give point per cell, runs of points near chord are replaced by chord
+  const size_t maxRun = 32;
+  size_t begin = loops[loops.size() - 2], n = loops.back() - begin;
+  double *pu = u.data() + begin, *pv = v.data() + begin;
+  auto isNear = [&](size_t a, size_t b) {
+    vec_t pa(pu[a], pv[a]), pb(pu[b % n], pv[b % n]), dir = pb - pa;
+    double len = dir.Len();
+    for (size_t i = a + 1; i < b; i++) {
+      vec_t d = vec_t(pu[i], pv[i]) - pa;
+      if ((len > 0 ? fabs(dir.Cross(d)) / len : d.Len()) > tolerance)
+        return false;
+    }
+    return true;
+  };
+
+  size_t numOfKept = 1;
+  for (size_t a = 0; ; ) {
+    size_t e = a + 1;
+    while (e < n && e - a < maxRun && isNear(a, e + 1))
+      e++;
+    if (e >= n)
+      break;
+    pu[numOfKept] = pu[e];
+    pv[numOfKept] = pv[e];
+    numOfKept++;
+    a = e;
+  }
+  u.resize(begin + numOfKept);
+  v.resize(begin + numOfKept);
+  loops.back() = u.size();
+}
+
+/**
+ * Trace contours of level function
+ * @param[in] level index of level
+ * @param[in] first index of the first crossed square of level in squares
+ * @param[in] last index after the last crossed square of level in squares
+ */
+void srm::offset_fill_t::TraceLevel(size_t level, size_t first, size_t last) {
+  double value = (level + 0.5) * step;
+  uint32_t numOfNodes = (uint32_t)(width * height);
+
+  // segments of squares are oriented with inside to the left, so segment starts on edge where
+  // counter clockwise bypass of square goes outside and ends on edge where it goes inside
+  starts.clear();
+  for (size_t k = first; k < last; k++) {
+    uint32_t s = squares[k].second, w = (uint32_t)width;
+    const uint32_t edges[4] = {s, numOfNodes + s + 1, s + w, numOfNodes + s};
+    const double values[4] = {dist[s], dist[s + 1], dist[s + w + 1], dist[s + w]};
+    bool isIn[4];
+    for (int c = 0; c < 4; c++)
+      isIn[c] = values[c] >= value;
+
+    int startEdges[2], endEdges[2], numOfStarts = 0, numOfEnds = 0;
+    for (int c = 0; c < 4; c++) {
+      if (isIn[c] && !isIn[(c + 1) % 4])
+        startEdges[numOfStarts++] = c;
+      else if (!isIn[c] && isIn[(c + 1) % 4])
+        endEdges[numOfEnds++] = c;
+    }
+    if (numOfStarts == 1) {
+      links[edges[startEdges[0]]] = edges[endEdges[0]];
+      starts.push_back(edges[startEdges[0]]);
+    }
+    else if (numOfStarts == 2) {
+      // saddle: inside corners are connected through the center if it is inside
+      bool isCenterIn = (values[0] + values[1] + values[2] + values[3]) / 4 >= value;
+      for (int i = 0; i < 2; i++) {
+        int c = startEdges[i];
+        links[edges[c]] = edges[isCenterIn ? (c + 1) % 4 : (c + 3) % 4];
+        starts.push_back(edges[c]);
+      }
+    }
+  }
+
+  // raster border is outside, so all contours are closed
+  double tolerance = cell / 4;
+  for (uint32_t start : starts) {
+    if (links[start] == none)
+      continue;
+    uint32_t edge = start;
+    do {
+      vec_t p = GetEdgePoint(edge, value);
+      u.push_back(p.x);
+      v.push_back(p.y);
+      uint32_t next = links[edge];
+      links[edge] = none;
+      edge = next;
+    } while (edge != start && edge != none);
+    loops.push_back(u.size());
+    levels.push_back(level);
+    SimplifyLoop(tolerance);
+    if (loops.back() - loops[loops.size() - 2] < 3) {
+      loops.pop_back();
+      levels.pop_back();
+      u.resize(loops.back());
+      v.resize(loops.back());
+    }
+  }
+}
+
+/**
+ * Get size of raster cell function
+ * @param[in] size size of bounding box of region in (u, v)
+ * @param[in] fillStep distance between offset contours
+ * @param[in] maxCells maximal number of raster cells
+ * @return size of cell (quarter of step if raster is not too big)
+ */
+double srm::offset_fill_t::GetCellSize(vec_t size, double fillStep, size_t maxCells) noexcept {
+  // contour is traced with accuracy of quarter of cell, so cell is quarter of step
+  // while raster is not too big
+  double cell = fillStep / 4, numOfCells = (size.x / cell + 3) * (size.y / cell + 3);
+  if (numOfCells > maxCells)
+    cell *= sqrt(numOfCells / maxCells);
+  return cell;
+}
+
+/**
+ * Build offset contours of region function
+ * @param[in] scanline sorted edge table of region
+ * @param[in, out] cursor cursor to scan region
+ * @param[in] rule rule of region interior
+ * @param[in] bboxMin, bboxMax bounding box of region in (u, v)
+ * @param[in] fillStep distance between offset contours
+ * @param[in] maxCells maximal number of raster cells (raster is coarsened for big regions)
+ */
+void srm::offset_fill_t::Build(const scanline_t &scanline, scanline_t::cursor_t *cursor, scanline_t::rule_t rule,
+  vec_t bboxMin, vec_t bboxMax, double fillStep, size_t maxCells) {
+  const double insideDist = 1e20;
+  u.clear();
+  v.clear();
+  loops.assign(1, 0);
+  levels.clear();
+
+  step = fillStep;
+  vec_t size = bboxMax - bboxMin;
+  cell = GetCellSize(size, step, maxCells);
+  uMin = bboxMin.x;
+  vMin = bboxMin.y;
+  // cells of raster border are outside, their centers are half cell out of bounding box
+  width = (size_t)ceil(size.x / cell) + 3;
+  height = (size_t)ceil(size.y / cell) + 3;
+
+  dist.assign(width * height, 0);
+  scanline.Start(cursor);
+  for (size_t j = 1; j + 1 < height; j++) {
+    const std::vector<double> &spans = scanline.GetSpans(cursor, vMin + (j - 0.5) * cell, rule);
+    double *row = dist.data() + j * width;
+    for (size_t k = 0; k + 1 < spans.size(); k += 2) {
+      double
+        first = std::max(1.0, ceil((spans[k] - uMin) / cell + 0.5)),
+        last = std::min(width - 2.0, floor((spans[k + 1] - uMin) / cell + 0.5));
+      for (double i = first; i <= last; i++)
+        row[(size_t)i] = insideDist;
+    }
+  }
+
+  // squared distance to the nearest outside cell by columns and then by rows
+  for (size_t i = 0; i < width; i++)
+    Transform(dist.data() + i, height, width);
+  for (size_t j = 0; j < height; j++)
+    Transform(dist.data() + j * width, width, 1);
+  for (double &d : dist)
+    d = d > 0 ? sqrt(d) * cell - cell / 2 : -cell / 2;
+
+  // square is crossed by levels between its minimal and maximal corner distances
+  squares.clear();
+  for (size_t j = 0; j + 1 < height; j++)
+    for (size_t i = 0; i + 1 < width; i++) {
+      size_t s = j * width + i;
+      double
+        dMin = std::min(std::min(dist[s], dist[s + 1]), std::min(dist[s + width], dist[s + width + 1])),
+        dMax = std::max(std::max(dist[s], dist[s + 1]), std::max(dist[s + width], dist[s + width + 1]));
+      if (dMax < step / 2)
+        continue;
+      double levelMin = std::max(0.0, floor(dMin / step - 0.5) + 1), levelMax = floor(dMax / step - 0.5);
+      for (double level = levelMin; level <= levelMax; level++)
+        squares.emplace_back((size_t)level, (uint32_t)s);
+    }
+  std::sort(squares.begin(), squares.end());
+
+  links.assign(2 * width * height, none);
+  for (size_t first = 0; first < squares.size(); ) {
+    size_t last = first;
+    while (last < squares.size() && squares[last].first == squares[first].first)
+      last++;
+    TraceLevel(squares[first].first, first, last);
+    first = last;
+  }
+}
+
+/**
+ * Check if segment lies in region function
+ * @param[in] a, b ends of segment
+ * @return true if segment is inside region up to raster accuracy, false - otherwise
+ */
+bool srm::offset_fill_t::IsInside(vec_t a, vec_t b) const noexcept {
+  size_t numOfSamples = (size_t)ceil((b - a).Len() / (cell / 2)) + 1;
+  for (size_t i = 0; i <= numOfSamples; i++)
+    if (GetDist(a + (b - a) * ((double)i / numOfSamples)) <= 0)
+      return false;
+  return true;
+}
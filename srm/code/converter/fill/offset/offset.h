@@ -0,0 +1,136 @@
+/**
+ * @file
+ * @brief Offset contours of region class header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains offset_fill_t class description to build contours of region offset inside by fill step
+ */
+
+#pragma once
+
+#ifndef __OFFSET_H_INCLUDED
+#define __OFFSET_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../../defs.h"
+#include "../scanline/scanline.h"
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * @brief Offset contours of region class
+   *
+   * Region is rasterised by scanlines and distance to its border is evaluated for every cell by exact euclidean
+   * distance transform. Offset contours are level lines of distance at half step from border and then by step,
+   * they are traced by marching squares, so splitting of region by offsetting is handled without special cases.
+   * Buffers are kept between regions, so filling does not allocate in steady state
+   */
+  class offset_fill_t {
+  public:
+    std::vector<double>
+      u,                         ///< u coordinates of points of all contours
+      v;                         ///< v coordinates of points of all contours
+    std::vector<size_t>
+      loops,                     ///< index of the first point of each contour (and total number of points at the end)
+      levels;                    ///< offset level of each contour (0 for contours at half step from border)
+
+  private:
+    static constexpr uint32_t none = (uint32_t)-1;  ///< absent edge of raster
+
+    double
+      uMin,                      ///< u of raster origin
+      vMin,                      ///< v of raster origin
+      cell,                      ///< size of raster cell
+      step;                      ///< distance between offset contours
+    size_t
+      width,                     ///< number of raster columns (including outer border)
+      height;                    ///< number of raster rows (including outer border)
+    std::vector<double> dist;    ///< signed distance to region border in cell centers (negative outside)
+    std::vector<double>
+      envelope,                  ///< scratch values of distance transform of row or column
+      bounds;                    ///< scratch bounds of parabolas of distance transform
+    std::vector<size_t> parabolas;  ///< scratch parabolas of distance transform
+    std::vector<std::pair<size_t, uint32_t>> squares;  ///< level and index of squares crossed by contours
+    std::vector<uint32_t> links;    ///< next edge of contour for each raster edge crossed by contour
+    std::vector<uint32_t> starts;   ///< edges crossed by contours of the current level
+
+    /**
+     * Distance transform of row or column function (lower envelope of parabolas)
+     * @param[in, out] values squared distances of row or column
+     * @param[in] n number of values
+     * @param[in] stride distance between values in array
+     */
+    void Transform(double *values, size_t n, size_t stride);
+
+    /**
+     * Trace contours of level function
+     * @param[in] level index of level
+     * @param[in] first index of the first crossed square of level in squares
+     * @param[in] last index after the last crossed square of level in squares
+     */
+    void TraceLevel(size_t level, size_t first, size_t last);
+
+    /**
+     * Get point of contour on raster edge function
+     * @param[in] edge index of edge
+     * @param[in] value distance of level
+     * @return u and v of point
+     */
+    vec_t GetEdgePoint(uint32_t edge, double value) const noexcept;
+
+    /**
+     * Get distance to border in point by bilinear interpolation function
+     * @param[in] p u and v of point
+     * @return distance to border (negative outside)
+     */
+    double GetDist(vec_t p) const noexcept;
+
+    /**
+     * Simplify the last contour function
+     * @param[in] tolerance maximal distance of removed points to simplified contour
+     */
+    void SimplifyLoop(double tolerance);
+
+  public:
+    /**
+     * Get size of raster cell function
+     * @param[in] size size of bounding box of region in (u, v)
+     * @param[in] fillStep distance between offset contours
+     * @param[in] maxCells maximal number of raster cells
+     * @return size of cell (quarter of step if raster is not too big)
+     */
+    static double GetCellSize(vec_t size, double fillStep, size_t maxCells) noexcept;
+
+    /**
+     * Build offset contours of region function
+     * @param[in] scanline sorted edge table of region
+     * @param[in, out] cursor cursor to scan region
+     * @param[in] rule rule of region interior
+     * @param[in] bboxMin, bboxMax bounding box of region in (u, v)
+     * @param[in] fillStep distance between offset contours
+     * @param[in] maxCells maximal number of raster cells (raster is coarsened for big regions)
+     */
+    void Build(const scanline_t &scanline, scanline_t::cursor_t *cursor, scanline_t::rule_t rule,
+      vec_t bboxMin, vec_t bboxMax, double fillStep, size_t maxCells);
+
+    /**
+     * Check if segment lies in region function
+     * @param[in] a, b ends of segment
+     * @return true if segment is inside region up to raster accuracy, false - otherwise
+     */
+    bool IsInside(vec_t a, vec_t b) const noexcept;
+
+    /**
+     * Get number of contours function
+     * @return number of contours
+     */
+    size_t GetNumOfLoops(void) const noexcept {
+      return levels.size();
+    }
+  };
+}
+
+#endif /* __OFFSET_H_INCLUDED */
@@ -0,0 +1,168 @@
+/**
+ * @file
+ * @brief Scanline region filling class source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains scanline_t class realisation to find spans of multi-contour region on scanlines
+ */
+
+#include <srm.h>
+
+#include <algorithm>
+
+/**
+ * Remove all contours keeping capacity function
+ */
+void srm::scanline_t::Clear(void) noexcept {
+  edges.clear();
+}
+
+/**
+ * Add closed contour of region function
+ * @param[in] u, v coordinates of contour vertices (the last vertex is connected to the first one)
+ * @param[in] numOfVertices number of vertices
+ */
+void srm::scanline_t::AddContour(const double *u, const double *v, size_t numOfVertices) {
+  for (size_t i = 0; i < numOfVertices; i++) {
+    size_t j = i + 1 < numOfVertices ? i + 1 : 0;
+    // edges along scanlines do not cross them
+    if (v[i] == v[j])
+      continue;
+    size_t lower = v[i] < v[j] ? i : j, upper = i + j - lower;
+    edges.push_back({v[lower], v[upper], u[lower], (u[upper] - u[lower]) / (v[upper] - v[lower]),
+      v[i] < v[j] ? 1 : -1});
+  }
+}
+
+/**
+ * Sort edges of region before scanning function
+ */
+void srm::scanline_t::Sort(void) {
+  std::sort(edges.begin(), edges.end(), [](const edge_t &e1, const edge_t &e2) {
+    return e1.vMin < e2.vMin;
+    });
+}
+
+/**
+ * Start scanning of band function
+ * @param[out] cursor cursor of band
+ */
+void srm::scanline_t::Start(cursor_t *cursor) const noexcept {
+  cursor->active.clear();
+  cursor->next = 0;
+}
+
+/**
+ * Update edges crossing scanline function
+ * @param[in, out] cursor cursor of band
+ * @param[in] v scanline coordinate (not less than previous one of cursor)
+ */
+void srm::scanline_t::Advance(cursor_t *cursor, double v) const {
+  // edges are half-open [vMin, vMax), so common vertex of 2 edges is crossed once;
+  // band may start at any scanline, edges ended below it are dropped at the first call
+  std::vector<size_t> &active = cursor->active;
+  while (cursor->next < edges.size() && edges[cursor->next].vMin <= v)
+    active.push_back(cursor->next++);
+  active.erase(std::remove_if(active.begin(), active.end(), [&](size_t i) {
+    return edges[i].vMax <= v;
+    }), active.end());
+}
+
+/**
+ * Get inner spans of region on scanline function. Edges must be sorted, scanlines of one cursor
+ * must be requested in increasing order of v
+ * @param[in, out] cursor cursor of band
+ * @param[in] v scanline coordinate
+ * @param[in] rule rule of region interior
+ * @return ends of spans in increasing order of u (span i is [res[2 * i], res[2 * i + 1]])
+ */
+const std::vector<double> & srm::scanline_t::GetSpans(cursor_t *cursor, double v, rule_t rule) const {
+  Advance(cursor, v);
+
+  std::vector<std::pair<double, int>> &crossings = cursor->crossings;
+  crossings.clear();
+  for (size_t i : cursor->active) {
+    const edge_t &e = edges[i];
+    crossings.emplace_back(e.u + (v - e.vMin) * e.slope, e.winding);
+  }
+  std::sort(crossings.begin(), crossings.end());
+
+  // span starts when interior is entered and ends when it is left
+  std::vector<double> &spans = cursor->spans;
+  spans.clear();
+  int winding = 0;
+  for (const auto &crossing : crossings) {
+    bool wasInside = winding != 0;
+    if (rule == rule_t::evenOdd)
+      winding ^= 1;
+    else
+      winding += crossing.second;
+    if (wasInside != (winding != 0))
+      spans.push_back(crossing.first);
+  }
+  return spans;
+}
+
+/**
+ * Get side of point relative to line function
+ * @param[in] a, b points of line
+ * @param[in] p point to check
+ * @param[in] tolerance distance to line to consider point lying on it
+ * @return 1 if point is to the left of line, -1 if to the right, 0 if point is on line
+ */
+static int _getSide(srm::vec_t a, srm::vec_t b, srm::vec_t p, double tolerance) noexcept {
+  double dist = (b - a).Cross(p - a) / (b - a).Len();
+  return dist > tolerance ? 1 : dist < -tolerance ? -1 : 0;
+}
+
+/**
+ * Check if link between adjacent scanlines lies in region function. Link is inside if no edge crosses it
+ * and a point near its middle is inside, so links along region border are inside too
+ * @param[in, out] cursor cursor of links (links must be requested in increasing order of start v)
+ * @param[in] a start of link on scanline
+ * @param[in] b end of link on the next scanline (b.y > a.y)
+ * @param[in] rule rule of region interior
+ * @return true if link is inside region, false - otherwise
+ */
+bool srm::scanline_t::IsLinkInside(cursor_t *cursor, vec_t a, vec_t b, rule_t rule) const {
+  Advance(cursor, a.y);
+
+  // ends of link lie on edges up to rounding, so sides are evaluated with tolerance
+  double
+    tolerance = 1e-9 * (fabs(a.x) + fabs(a.y) + fabs(b.x) + fabs(b.y) + 1),
+    shift = 1e-6 * (b - a).Len();
+  vec_t middle = (a + b) / 2;
+  int windingLeft = 0, windingRight = 0;  // winding numbers of points to the left and right from middle
+
+  auto checkEdge = [&](const edge_t &e) {
+    vec_t p(e.u, e.vMin), q(e.u + (e.vMax - e.vMin) * e.slope, e.vMax);
+    int
+      sideP = _getSide(a, b, p, tolerance), sideQ = _getSide(a, b, q, tolerance),
+      sideA = _getSide(p, q, a, tolerance), sideB = _getSide(p, q, b, tolerance);
+    // edge crosses link or its vertex touches link between its ends
+    if (sideA * sideB < 0 && sideP * sideQ <= 0 && (sideP != 0 || sideQ != 0))
+      return false;
+    if (e.vMin <= middle.y && middle.y < e.vMax) {
+      double u = e.u + (middle.y - e.vMin) * e.slope;
+      if (u < middle.x - shift)
+        windingLeft += e.winding;
+      if (u < middle.x + shift)
+        windingRight += e.winding;
+    }
+    return true;
+  };
+
+  // edges between scanlines are active ones and ones starting before the next scanline
+  for (size_t i : cursor->active)
+    if (!checkEdge(edges[i]))
+      return false;
+  for (size_t i = cursor->next; i < edges.size() && edges[i].vMin < b.y; i++)
+    if (!checkEdge(edges[i]))
+      return false;
+
+  auto isInside = [rule](int winding) {
+    return rule == rule_t::evenOdd ? (winding & 1) != 0 : winding != 0;
+  };
+  return isInside(windingLeft) || isInside(windingRight);
+}
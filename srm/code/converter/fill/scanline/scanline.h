@@ -0,0 +1,124 @@
+/**
+ * @file
+ * @brief Scanline region filling class header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains scanline_t class description to find spans of multi-contour region on scanlines
+ */
+
+#pragma once
+
+#ifndef __SCANLINE_H_INCLUDED
+#define __SCANLINE_H_INCLUDED
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "../../defs.h"
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * @brief Scanline region filling class
+   *
+   * Region is set by closed contours in (u, v) coordinates and is scanned by lines v = const in increasing order.
+   * Edges are sorted by their lower end once (sorted edge table) and only edges crossing the current scanline
+   * are kept in active edge table, so each scanline costs the number of crossings instead of the number of edges.
+   * Buffers are kept between regions, so filling does not allocate in steady state
+   */
+  class scanline_t {
+  public:
+    /**
+     * @brief Rule of region interior
+     */
+    enum class rule_t {
+      nonZero,  ///< point is inside if winding number is not zero
+      evenOdd   ///< point is inside if number of crossings is odd
+    };
+
+    /**
+     * @brief State of scanning of one band of scanlines
+     *
+     * Edge table is shared and read only while scanning, so bands of one region are scanned in parallel
+     * by their own cursors
+     */
+    class cursor_t {
+      friend class scanline_t;
+
+      std::vector<size_t> active;                    ///< indices of edges crossing the current scanline
+      std::vector<std::pair<double, int>> crossings; ///< u and winding of crossings of the current scanline
+      std::vector<double> spans;                     ///< ends of inner spans of the current scanline
+      size_t next = 0;                               ///< index of the first edge not activated yet
+    };
+
+  private:
+    /**
+     * @brief Edge of region struct
+     */
+    struct edge_t {
+      double
+        vMin,     ///< v of the lower end
+        vMax,     ///< v of the upper end
+        u,        ///< u of the lower end
+        slope;    ///< du / dv
+      int winding;  ///< 1 if edge goes up by v, -1 - otherwise
+    };
+
+    std::vector<edge_t> edges;                     ///< edges of region (sorted by vMin after Sort())
+
+    /**
+     * Update edges crossing scanline function
+     * @param[in, out] cursor cursor of band
+     * @param[in] v scanline coordinate (not less than previous one of cursor)
+     */
+    void Advance(cursor_t *cursor, double v) const;
+
+  public:
+    /**
+     * Remove all contours keeping capacity function
+     */
+    void Clear(void) noexcept;
+
+    /**
+     * Add closed contour of region function
+     * @param[in] u, v coordinates of contour vertices (the last vertex is connected to the first one)
+     * @param[in] numOfVertices number of vertices
+     */
+    void AddContour(const double *u, const double *v, size_t numOfVertices);
+
+    /**
+     * Sort edges of region before scanning function
+     */
+    void Sort(void);
+
+    /**
+     * Start scanning of band function
+     * @param[out] cursor cursor of band
+     */
+    void Start(cursor_t *cursor) const noexcept;
+
+    /**
+     * Get inner spans of region on scanline function. Edges must be sorted, scanlines of one cursor
+     * must be requested in increasing order of v
+     * @param[in, out] cursor cursor of band
+     * @param[in] v scanline coordinate
+     * @param[in] rule rule of region interior
+     * @return ends of spans in increasing order of u (span i is [res[2 * i], res[2 * i + 1]])
+     */
+    const std::vector<double> & GetSpans(cursor_t *cursor, double v, rule_t rule) const;
+
+    /**
+     * Check if link between adjacent scanlines lies in region function. Link is inside if no edge crosses it
+     * and a point near its middle is inside, so links along region border are inside too
+     * @param[in, out] cursor cursor of links (links must be requested in increasing order of start v)
+     * @param[in] a start of link on scanline
+     * @param[in] b end of link on the next scanline (b.y > a.y)
+     * @param[in] rule rule of region interior
+     * @return true if link is inside region, false - otherwise
+     */
+    bool IsLinkInside(cursor_t *cursor, vec_t a, vec_t b, rule_t rule) const;
+  };
+}
+
+#endif /* __SCANLINE_H_INCLUDED */
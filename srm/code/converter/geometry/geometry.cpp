@@ -0,0 +1,107 @@
+/**
+ * @file
+ * @brief Geometry store class source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains geometry_t class realisation to keep polylines of whole document in flat arrays
+ */
+
+#include <srm.h>
+
+#include <algorithm>
+#include <string>
+
+/**
+ * Default constructor
+ */
+srm::geometry_t::geometry_t(void) : offsets(1, 0) {
+}
+
+/**
+ * Remove all primitives keeping capacity function
+ */
+void srm::geometry_t::Clear(void) noexcept {
+  x.clear();
+  y.clear();
+  offsets.resize(1);
+  flags.clear();
+  bboxes.clear();
+}
+
+/**
+ * Close open primitive function. Bounding box and closed flag are evaluated here
+ * @param[in] primFlags primitive flags (closed flag is set automatically)
+ */
+void srm::geometry_t::Close(uint8_t primFlags) {
+  const double eps = 1e-4; // defines when primitive is considered closed
+  size_t begin = offsets.back(), end = x.size();
+
+  bbox_t bbox{vec_t(x[begin], y[begin]), vec_t(x[begin], y[begin])};
+  for (size_t i = begin + 1; i < end; i++) {
+    bbox.min.x = std::min(bbox.min.x, x[i]);
+    bbox.min.y = std::min(bbox.min.y, y[i]);
+    bbox.max.x = std::max(bbox.max.x, x[i]);
+    bbox.max.y = std::max(bbox.max.y, y[i]);
+  }
+
+  primFlags &= ~closed;
+  if (end - begin > 1 && (GetPoint(end - 1) - GetPoint(begin)).Len() <= eps)
+    primFlags |= closed;
+
+  offsets.push_back(end);
+  flags.push_back(primFlags);
+  bboxes.push_back(bbox);
+}
+
+/**
+ * Remove points of open primitive function
+ */
+void srm::geometry_t::Discard(void) noexcept {
+  x.resize(offsets.back());
+  y.resize(offsets.back());
+}
+
+/**
+ * Remove primitives from the given one to the end keeping capacity function
+ * @param[in] size number of primitives to keep
+ * @warning geometry mustn't have open primitive
+ */
+void srm::geometry_t::Truncate(size_t size) noexcept {
+  x.resize(offsets[size]);
+  y.resize(offsets[size]);
+  offsets.resize(size + 1);
+  flags.resize(size);
+  bboxes.resize(size);
+}
+
+/**
+ * Generate code of primitive and write it to output stream
+ * @param[in] out output stream
+ * @param[in] roboConf robot configuration
+ * @param[in] prim index of primitive
+ * @param[in, out] buf scratch buffer for robot coordinates of primitive points
+ */
+void srm::geometry_t::GenCode(std::ostream &out, const robot_conf_t &roboConf, size_t prim, std::vector<double> *buf) const {
+  size_t begin = offsets[prim], n = offsets[prim + 1] - begin;
+
+  // svg coordinates are mapped to robot ones at once
+  buf->resize(2 * n);
+  double *robotX = buf->data(), *robotY = buf->data() + n;
+  kernels::Scale(roboConf.GetXScale(), roboConf.GetYScale(), x.data() + begin, y.data() + begin, robotX, robotY, n);
+
+  out << "\tLAPPRO frm + SHIFT (P BY " +
+    std::to_string(robotX[0]) + ", " +
+    std::to_string(robotY[0]) + ", 0), " << std::to_string(roboConf.GetDepDist()) << "\n";
+
+  out << "\tLMOVE frm + SHIFT (P BY " +
+    std::to_string(robotX[0]) + ", " +
+    std::to_string(robotY[0]) + ", 0)\n";
+
+  for (size_t i = 1; i < n; i++)
+    out << "\tLMOVE frm + SHIFT (P BY " +
+      std::to_string(robotX[i]) + ", " +
+      std::to_string(robotY[i]) + ", 0)\n";
+
+  out << "\tLDEPART " << std::to_string(roboConf.GetDepDist()) << "\n";
+}
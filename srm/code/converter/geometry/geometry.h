@@ -0,0 +1,214 @@
+/**
+ * @file
+ * @brief Geometry store class header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains geometry_t class description to keep polylines of whole document in flat arrays
+ */
+
+#pragma once
+
+#ifndef __GEOMETRY_H_INCLUDED
+#define __GEOMETRY_H_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "../defs.h"
+#include "../robot_conf/robot_conf.h"
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * @brief Bounding box struct
+   */
+  struct bbox_t {
+    vec_t
+      min,  ///< minimal coordinates
+      max;  ///< maximal coordinates
+
+    /**
+     * Extend box to contain point function
+     * @param[in] p point
+     */
+    void Add(const vec_t &p) noexcept {
+      min.x = std::min(min.x, p.x);
+      min.y = std::min(min.y, p.y);
+      max.x = std::max(max.x, p.x);
+      max.y = std::max(max.y, p.y);
+    }
+
+    /**
+     * Check if box does not intersect rectangle [0, w] x [0, h] function
+     * @param[in] w width of rectangle
+     * @param[in] h height of rectangle
+     * @return true if box is out of rectangle, false - otherwise
+     */
+    bool IsOut(double w, double h) const noexcept {
+      return max.x < 0 || max.y < 0 || min.x > w || min.y > h;
+    }
+  };
+
+  /**
+   * @brief Geometry store class
+   *
+   * Polylines (primitives) of document in CSR-like layout: coordinates of all points are kept in x and y arrays,
+   * points of primitive i are [offsets[i], offsets[i + 1]). The first point of primitive is its start,
+   * each next point is end of one line segment.
+   * Primitive is built by adding points to open primitive and closing it by Close().
+   */
+  class geometry_t {
+  public:
+    /**
+     * @brief Primitive flags
+     */
+    enum flags_t : uint8_t {
+      fill = 1,    ///< primitive must be filled
+      closed = 2,  ///< the last point coincides with the start
+      evenOdd = 4, ///< fill region by even-odd rule (nonzero otherwise)
+      subpath = 8, ///< primitive continues fill region of the previous primitive
+      boustrophedon = 16,  ///< fill region by zigzags of monotone cells (by hatch lines otherwise)
+      offset = 32  ///< fill region by offset contours (by hatch lines otherwise)
+    };
+
+    std::vector<double>
+      x,                          ///< x coordinates of all points
+      y;                          ///< y coordinates of all points
+    std::vector<size_t> offsets;  ///< index of the first point of each primitive (and total number of closed points at the end)
+    std::vector<uint8_t> flags;   ///< flags of each primitive
+    std::vector<bbox_t> bboxes;   ///< bounding box of each primitive
+
+    /**
+     * Default constructor
+     */
+    geometry_t(void);
+
+    /**
+     * Remove all primitives keeping capacity function
+     */
+    void Clear(void) noexcept;
+
+    /**
+     * Add point to open primitive function
+     * @param[in] px x coordinate
+     * @param[in] py y coordinate
+     */
+    void Add(double px, double py) {
+      x.push_back(px);
+      y.push_back(py);
+    }
+
+    /**
+     * Add point to open primitive function
+     * @param[in] p point
+     */
+    void Add(const vec_t &p) {
+      Add(p.x, p.y);
+    }
+
+    /**
+     * Add points with coordinates to be set later to open primitive function
+     * @param[in] n number of points
+     * @return index of the first added point
+     * @warning coordinates must be set before primitive is closed
+     */
+    size_t AddPlaceholders(size_t n) {
+      size_t first = x.size();
+      x.resize(first + n);
+      y.resize(first + n);
+      return first;
+    }
+
+    /**
+     * Close open primitive function. Bounding box and closed flag are evaluated here
+     * @param[in] primFlags primitive flags (closed flag is set automatically)
+     */
+    void Close(uint8_t primFlags = 0);
+
+    /**
+     * Remove points of open primitive function
+     */
+    void Discard(void) noexcept;
+
+    /**
+     * Remove primitives from the given one to the end keeping capacity function
+     * @param[in] size number of primitives to keep
+     * @warning geometry mustn't have open primitive
+     */
+    void Truncate(size_t size) noexcept;
+
+    /**
+     * Get index of the first point of open primitive function
+     * @return index of point
+     */
+    size_t GetOpenBegin(void) const noexcept {
+      return offsets.back();
+    }
+
+    /**
+     * Get number of points in open primitive function
+     * @return number of points
+     */
+    size_t GetOpenSize(void) const noexcept {
+      return x.size() - offsets.back();
+    }
+
+    /**
+     * Get number of closed primitives function
+     * @return number of primitives
+     */
+    size_t Size(void) const noexcept {
+      return flags.size();
+    }
+
+    /**
+     * Get index of the first point of primitive function
+     * @param[in] prim index of primitive
+     * @return index of point
+     */
+    size_t Begin(size_t prim) const noexcept {
+      return offsets[prim];
+    }
+
+    /**
+     * Get index after the last point of primitive function
+     * @param[in] prim index of primitive
+     * @return index of point
+     */
+    size_t End(size_t prim) const noexcept {
+      return offsets[prim + 1];
+    }
+
+    /**
+     * Get point function
+     * @param[in] i index of point
+     * @return point
+     */
+    vec_t GetPoint(size_t i) const noexcept {
+      return vec_t(x[i], y[i]);
+    }
+
+    /**
+     * Get number of line segments of primitive function
+     * @param[in] prim index of primitive
+     * @return number of segments
+     */
+    size_t GetNumOfSegments(size_t prim) const noexcept {
+      return offsets[prim + 1] - offsets[prim] - 1;
+    }
+
+    /**
+     * Generate code of primitive and write it to output stream
+     * @param[in] out output stream
+     * @param[in] roboConf robot configuration
+     * @param[in] prim index of primitive
+     * @param[in, out] buf scratch buffer for robot coordinates of primitive points
+     */
+    void GenCode(std::ostream &out, const robot_conf_t &roboConf, size_t prim, std::vector<double> *buf) const;
+  };
+}
+
+#endif /* __GEOMETRY_H_INCLUDED */
@@ -0,0 +1,219 @@
+/**
+ * @file
+ * @brief Coordinate kernels source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains realisation of scalar, SSE2 and AVX2 kernels to transform and scale contiguous coordinate arrays.
+ * AVX2 kernels are compiled for their target only and are chosen at run time by processor support
+ */
+
+#include <srm.h>
+
+#if defined(__SRM_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// all kernels multiply and add separately in the same order, so results do not depend on instruction set
+
+/**
+ * Apply affine matrix to points by scalar code
+ * @param[in] matrix affine matrix
+ * @param[in, out] x, y coordinates of points
+ * @param[in] begin index of the first point
+ * @param[in] end index after the last point
+ */
+static void _affineScalar(const double (&matrix)[2][3], double *x, double *y, size_t begin, size_t end) noexcept {
+  for (size_t i = begin; i < end; i++) {
+    double tmp = x[i];
+    x[i] = matrix[0][0] * x[i] + matrix[0][1] * y[i] + matrix[0][2];
+    y[i] = matrix[1][0] * tmp + matrix[1][1] * y[i] + matrix[1][2];
+  }
+}
+
+/**
+ * Scale points by scalar code
+ * @param[in] scaleX, scaleY scales by axes
+ * @param[in] x, y coordinates of points
+ * @param[out] resX, resY scaled coordinates
+ * @param[in] begin index of the first point
+ * @param[in] end index after the last point
+ */
+static void _scaleScalar(double scaleX, double scaleY, const double *x, const double *y, double *resX, double *resY,
+  size_t begin, size_t end) noexcept {
+  for (size_t i = begin; i < end; i++) {
+    resX[i] = x[i] * scaleX;
+    resY[i] = y[i] * scaleY;
+  }
+}
+
+#ifdef __SRM_X86
+/**
+ * Apply affine matrix to points by SSE2 code
+ * @param[in] matrix affine matrix
+ * @param[in, out] x, y coordinates of points
+ * @param[in] n number of points
+ * @return number of processed points (the rest is left for scalar code)
+ */
+static size_t _affineSse2(const double (&matrix)[2][3], double *x, double *y, size_t n) noexcept {
+  const __m128d
+    m00 = _mm_set1_pd(matrix[0][0]), m01 = _mm_set1_pd(matrix[0][1]), m02 = _mm_set1_pd(matrix[0][2]),
+    m10 = _mm_set1_pd(matrix[1][0]), m11 = _mm_set1_pd(matrix[1][1]), m12 = _mm_set1_pd(matrix[1][2]);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d px = _mm_loadu_pd(x + i), py = _mm_loadu_pd(y + i);
+    _mm_storeu_pd(x + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(m00, px), _mm_mul_pd(m01, py)), m02));
+    _mm_storeu_pd(y + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(m10, px), _mm_mul_pd(m11, py)), m12));
+  }
+  return i;
+}
+
+/**
+ * Scale points by SSE2 code
+ * @param[in] scaleX, scaleY scales by axes
+ * @param[in] x, y coordinates of points
+ * @param[out] resX, resY scaled coordinates
+ * @param[in] n number of points
+ * @return number of processed points (the rest is left for scalar code)
+ */
+static size_t _scaleSse2(double scaleX, double scaleY, const double *x, const double *y, double *resX, double *resY,
+  size_t n) noexcept {
+  const __m128d sx = _mm_set1_pd(scaleX), sy = _mm_set1_pd(scaleY);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(resX + i, _mm_mul_pd(_mm_loadu_pd(x + i), sx));
+    _mm_storeu_pd(resY + i, _mm_mul_pd(_mm_loadu_pd(y + i), sy));
+  }
+  return i;
+}
+
+/**
+ * Apply affine matrix to points by AVX2 code
+ * @param[in] matrix affine matrix
+ * @param[in, out] x, y coordinates of points
+ * @param[in] n number of points
+ * @return number of processed points (the rest is left for scalar code)
+ */
+__SRM_TARGET_AVX2 static size_t _affineAvx2(const double (&matrix)[2][3], double *x, double *y, size_t n) noexcept {
+  const __m256d
+    m00 = _mm256_set1_pd(matrix[0][0]), m01 = _mm256_set1_pd(matrix[0][1]), m02 = _mm256_set1_pd(matrix[0][2]),
+    m10 = _mm256_set1_pd(matrix[1][0]), m11 = _mm256_set1_pd(matrix[1][1]), m12 = _mm256_set1_pd(matrix[1][2]);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d px = _mm256_loadu_pd(x + i), py = _mm256_loadu_pd(y + i);
+    _mm256_storeu_pd(x + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m00, px), _mm256_mul_pd(m01, py)), m02));
+    _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m10, px), _mm256_mul_pd(m11, py)), m12));
+  }
+  return i;
+}
+
+/**
+ * Scale points by AVX2 code
+ * @param[in] scaleX, scaleY scales by axes
+ * @param[in] x, y coordinates of points
+ * @param[out] resX, resY scaled coordinates
+ * @param[in] n number of points
+ * @return number of processed points (the rest is left for scalar code)
+ */
+__SRM_TARGET_AVX2 static size_t _scaleAvx2(double scaleX, double scaleY, const double *x, const double *y,
+  double *resX, double *resY, size_t n) noexcept {
+  const __m256d sx = _mm256_set1_pd(scaleX), sy = _mm256_set1_pd(scaleY);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(resX + i, _mm256_mul_pd(_mm256_loadu_pd(x + i), sx));
+    _mm256_storeu_pd(resY + i, _mm256_mul_pd(_mm256_loadu_pd(y + i), sy));
+  }
+  return i;
+}
+
+/**
+ * Check if processor and operating system support AVX2
+ * @return true if AVX2 is supported, false - otherwise
+ */
+static bool _hasAvx2(void) noexcept {
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuid(info, 1);
+  // OS saves AVX registers
+  bool hasOsAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+  __cpuidex(info, 7, 0);
+  return hasOsAvx && (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+/**
+ * Get the best instruction set supported by processor function (checked once at the first call)
+ * @return instruction set
+ */
+srm::kernels::isa_t srm::kernels::GetBestIsa(void) noexcept {
+#ifdef __SRM_X86
+  static const isa_t isa = _hasAvx2() ? isa_t::avx2 : isa_t::sse2;
+  return isa;
+#else
+  return isa_t::scalar;
+#endif
+}
+
+/**
+ * Get name of instruction set function
+ * @param[in] isa instruction set
+ * @return name
+ */
+const char * srm::kernels::GetIsaName(isa_t isa) noexcept {
+  switch (isa) {
+  case isa_t::sse2:
+    return "sse2";
+  case isa_t::avx2:
+    return "avx2";
+  default:
+    return "scalar";
+  }
+}
+
+/**
+ * Apply affine matrix to points in place function
+ * @param[in] matrix affine matrix [[m00 m01 m02] [m10 m11 m12]]
+ * @param[in, out] x x coordinates of points
+ * @param[in, out] y y coordinates of points
+ * @param[in] n number of points
+ * @param[in] isa instruction set (must be supported by processor)
+ */
+void srm::kernels::Affine(const double (&matrix)[2][3], double *x, double *y, size_t n, isa_t isa) noexcept {
+  size_t done = 0;
+#ifdef __SRM_X86
+  if (isa == isa_t::avx2)
+    done = _affineAvx2(matrix, x, y, n);
+  else if (isa == isa_t::sse2)
+    done = _affineSse2(matrix, x, y, n);
+#endif
+  _affineScalar(matrix, x, y, done, n);
+}
+
+/**
+ * Scale points by axes function
+ * @param[in] scaleX scale by x
+ * @param[in] scaleY scale by y
+ * @param[in] x x coordinates of points
+ * @param[in] y y coordinates of points
+ * @param[out] resX scaled x coordinates (may be equal to x)
+ * @param[out] resY scaled y coordinates (may be equal to y)
+ * @param[in] n number of points
+ * @param[in] isa instruction set (must be supported by processor)
+ */
+void srm::kernels::Scale(double scaleX, double scaleY, const double *x, const double *y, double *resX, double *resY,
+  size_t n, isa_t isa) noexcept {
+  size_t done = 0;
+#ifdef __SRM_X86
+  if (isa == isa_t::avx2)
+    done = _scaleAvx2(scaleX, scaleY, x, y, resX, resY, n);
+  else if (isa == isa_t::sse2)
+    done = _scaleSse2(scaleX, scaleY, x, y, resX, resY, n);
+#endif
+  _scaleScalar(scaleX, scaleY, x, y, resX, resY, done, n);
+}
@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @brief Coordinate kernels header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains declaration of vectorised kernels to transform and scale contiguous coordinate arrays
+ */
+
+#pragma once
+
+#ifndef __KERNELS_H_INCLUDED
+#define __KERNELS_H_INCLUDED
+
+#include <cstddef>
+
+// translation units with SIMD kernels compile AVX2 code for its target only and choose it at run time
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define __SRM_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#define __SRM_TARGET_AVX2
+#else
+#define __SRM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+/** \brief Project namespace */
+namespace srm {
+  /** \brief Coordinate kernels namespace */
+  namespace kernels {
+    /**
+     * @brief Instruction set of kernels
+     */
+    enum class isa_t {
+      scalar,  ///< plain C++ code
+      sse2,    ///< 2 coordinates per instruction
+      avx2     ///< 4 coordinates per instruction
+    };
+
+    /**
+     * Get the best instruction set supported by processor function (checked once at the first call)
+     * @return instruction set
+     */
+    isa_t GetBestIsa(void) noexcept;
+
+    /**
+     * Get name of instruction set function
+     * @param[in] isa instruction set
+     * @return name
+     */
+    const char * GetIsaName(isa_t isa) noexcept;
+
+    /**
+     * Apply affine matrix to points in place function
+     * @param[in] matrix affine matrix [[m00 m01 m02] [m10 m11 m12]]
+     * @param[in, out] x x coordinates of points
+     * @param[in, out] y y coordinates of points
+     * @param[in] n number of points
+     * @param[in] isa instruction set (must be supported by processor)
+     */
+    void Affine(const double (&matrix)[2][3], double *x, double *y, size_t n, isa_t isa = GetBestIsa()) noexcept;
+
+    /**
+     * Scale points by axes function
+     * @param[in] scaleX scale by x
+     * @param[in] scaleY scale by y
+     * @param[in] x x coordinates of points
+     * @param[in] y y coordinates of points
+     * @param[out] resX scaled x coordinates (may be equal to x)
+     * @param[out] resY scaled y coordinates (may be equal to y)
+     * @param[in] n number of points
+     * @param[in] isa instruction set (must be supported by processor)
+     */
+    void Scale(double scaleX, double scaleY, const double *x, const double *y, double *resX, double *resY, size_t n,
+      isa_t isa = GetBestIsa()) noexcept;
+  }
+}
+
+#endif /* __KERNELS_H_INCLUDED */
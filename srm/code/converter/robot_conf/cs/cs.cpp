@@ -109,7 +109,7 @@ srm::vec3_t srm::cs_t::SvgToRobot(vec_t point) const noexcept {
  * Get ratio of canvas width to svg image width
  * @return ratio of canvas width to svg image width
  */
-double srm::cs_t::GetXScale() {
+double srm::cs_t::GetXScale(void) const noexcept {
   return boardI.Len() / width;
 }
 
@@ -117,7 +117,7 @@ double srm::cs_t::GetXScale() {
  * Get ratio of canvas height to svg image height
  * @return ratio of canvas height to svg image height
  */
-double srm::cs_t::GetYScale() {
+double srm::cs_t::GetYScale(void) const noexcept {
   return boardJ.Len() / height;
 }
 
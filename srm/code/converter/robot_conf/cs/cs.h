@@ -108,13 +108,13 @@ namespace srm {
      * Get ratio of canvas width to svg image width
      * @return ratio of canvas width to svg image width
      */
-    double GetXScale();
+    double GetXScale(void) const noexcept;
 
     /**
      * Get ratio of canvas height to svg image height
      * @return ratio of canvas height to svg image height
      */
-    double GetYScale();
+    double GetYScale(void) const noexcept;
 
     /**
      * Get board angle point p1
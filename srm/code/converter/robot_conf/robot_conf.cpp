@@ -33,7 +33,10 @@ namespace srm {
         vel,                                     ///< velocity of robot moving
         dist,                                    ///< distance of departure
         accuracy,                                ///< robot accuracy
-        pouringStep;                             ///< step for pouring
+        pouringStep,                             ///< step for pouring
+        flat,                                    ///< curve sampling by flatness flag (optional)
+        boust,                                   ///< boustrophedon hatching flag (optional)
+        offset;                                  ///< offset contours hatching flag (optional)
       std::pair<bool, std::string> programName;  ///< name of program
     };
 
@@ -119,6 +122,36 @@ static void _stepFunc(srm::rcf::robot_file_t *rConf, const std::vector<double> &
   rConf->pouringStep.second = params[0];
 }
 
+/**
+ * flat command parser function
+ * @param[out] rConf robot configuration file variable
+ * @param[in] params line param
+ */
+static void _flatFunc(srm::rcf::robot_file_t *rConf, const std::vector<double> &params) {
+  rConf->flat.first = true;
+  rConf->flat.second = params[0];
+}
+
+/**
+ * boust command parser function
+ * @param[out] rConf robot configuration file variable
+ * @param[in] params line param
+ */
+static void _boustFunc(srm::rcf::robot_file_t *rConf, const std::vector<double> &params) {
+  rConf->boust.first = true;
+  rConf->boust.second = params[0];
+}
+
+/**
+ * offset command parser function
+ * @param[out] rConf robot configuration file variable
+ * @param[in] params line param
+ */
+static void _offsetFunc(srm::rcf::robot_file_t *rConf, const std::vector<double> &params) {
+  rConf->offset.first = true;
+  rConf->offset.second = params[0];
+}
+
 static std::map<const std::string, srm::rcf::line_t> s_Lines = {
   {"p1", {_p1Func, 3}},
   {"p2", {_p2Func, 3}},
@@ -126,7 +159,16 @@ static std::map<const std::string, srm::rcf::line_t> s_Lines = {
   {"vel", {_velFunc, 1}},
   {"dist", {_distFunc, 1}},
   {"accu", {_accuFunc, 1}},
-  {"step", {_stepFunc, 1}}
+  {"step", {_stepFunc, 1}},
+  {"flat", {_flatFunc, 1}},
+  {"boust", {_boustFunc, 1}},
+  {"offset", {_offsetFunc, 1}}
+};
+
+static std::map<const std::string, srm::hatching_t> s_Hatchings = {
+  {"lines", srm::hatching_t::lines},
+  {"boust", srm::hatching_t::boustrophedon},
+  {"offset", srm::hatching_t::offset}
 };
 
 /**
@@ -135,9 +177,13 @@ static std::map<const std::string, srm::rcf::line_t> s_Lines = {
  */
 void srm::robot_conf_t::LoadConf(const std::string &confFileName) {
   std::ifstream iFStream(confFileName);
+  if (!iFStream.is_open())
+    throw std::exception("Failed to open robot configuration file");
 
   int lineNum = 0;
   rcf::robot_file_t roboFile = {};
+  idsHatching.clear();
+  classesHatching.clear();
 
   while (!iFStream.eof()) {
     lineNum++;
@@ -159,6 +205,21 @@ void srm::robot_conf_t::LoadConf(const std::string &confFileName) {
       continue;
     }
 
+    // hatching mode of elements with id or class: 'fillid <id> <mode>', 'fillclass <class> <mode>'
+    if (splitedLine.size() > 0 && (splitedLine[0] == "fillid" || splitedLine[0] == "fillclass")) {
+      if (splitedLine.size() != 3)
+        throw std::exception((std::string("Incorrect number of parameters in '") + splitedLine[0] + "' in line #" + std::to_string(lineNum)).c_str());
+      auto hatching = s_Hatchings.find(splitedLine[2]);
+      if (hatching == s_Hatchings.end())
+        throw std::exception((std::string("Incorrect argument in '") + splitedLine[0] + "' in line #" + std::to_string(lineNum)).c_str());
+
+      (splitedLine[0] == "fillid" ? idsHatching : classesHatching)[splitedLine[1]] = hatching->second;
+      continue;
+    }
+
+    if (splitedLine.size() == 0)
+      continue;
+
     auto lineStruct = s_Lines.find(splitedLine[0]);
     if (lineStruct == s_Lines.end())
       continue;
@@ -185,6 +246,12 @@ void srm::robot_conf_t::LoadConf(const std::string &confFileName) {
   accuracy = roboFile.accuracy.second;
   pouringStep = roboFile.pouringStep.second;
   programName = roboFile.programName.second;
+  sampling = roboFile.flat.first && roboFile.flat.second != 0 ? sampling_t::flatness : sampling_t::chord;
+  hatching = hatching_t::lines;
+  if (roboFile.offset.first && roboFile.offset.second != 0)
+    hatching = hatching_t::offset;
+  else if (roboFile.boust.first && roboFile.boust.second != 0)
+    hatching = hatching_t::boustrophedon;
 }
 
 /**
@@ -219,6 +286,47 @@ double srm::robot_conf_t::GetSvgAcc(void) const noexcept {
   return SvgToRobotAcc(accuracy);
 }
 
+/**
+ * Get curve sampling mode function.
+ * @return sampling mode
+ */
+srm::sampling_t srm::robot_conf_t::GetSampling(void) const noexcept {
+  return sampling;
+}
+
+/**
+ * Get fill hatching mode function.
+ * @return hatching mode
+ */
+srm::hatching_t srm::robot_conf_t::GetHatching(void) const noexcept {
+  return hatching;
+}
+
+/**
+ * Get fill hatching mode of element function. Mode set for id is used first, then mode of the first class
+ * with set mode, then common mode
+ * @param[in] id id of element (may be empty)
+ * @param[in] classes space separated classes of element (may be empty)
+ * @return hatching mode
+ */
+srm::hatching_t srm::robot_conf_t::GetHatching(const std::string &id, const std::string &classes) const {
+  if (!id.empty()) {
+    auto found = idsHatching.find(id);
+    if (found != idsHatching.end())
+      return found->second;
+  }
+  if (!classes.empty() && !classesHatching.empty()) {
+    std::istringstream classStream(classes);
+    std::string className;
+    while (classStream >> className) {
+      auto found = classesHatching.find(className);
+      if (found != classesHatching.end())
+        return found->second;
+    }
+  }
+  return hatching;
+}
+
 /**
  * Get pouring step value function.
  * @return pouring step
@@ -227,6 +335,14 @@ double srm::robot_conf_t::GetPouringStep(void) const noexcept {
   return pouringStep;
 }
 
+/**
+ * Set pouring step value function.
+ * @param[in] step pouring step
+ */
+void srm::robot_conf_t::SetPouringStep(double step) noexcept {
+  pouringStep = step;
+}
+
 /**
  * Get program name function.
  * @return string wirh program name
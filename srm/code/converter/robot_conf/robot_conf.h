@@ -12,11 +12,34 @@
 #ifndef __ROBOT_CONF_H_INCLUDED
 #define __ROBOT_CONF_H_INCLUDED
 
+#include <map>
+#include <string>
 #include "../defs.h"
 #include "../robot_conf/cs/cs.h"
 
 /** \brief Project namespace */
 namespace srm {
+  /**
+   * @brief Curve sampling mode
+   *
+   * Contains possible ways to bound error of curve sampling by accuracy
+   */
+  enum class sampling_t {
+    chord,    ///< length of segments is not greater than accuracy
+    flatness  ///< deviation of segments from curve is not greater than accuracy
+  };
+
+  /**
+   * @brief Fill hatching mode
+   *
+   * Contains possible ways to paint hatch lines of fill regions
+   */
+  enum class hatching_t {
+    lines,         ///< every hatch segment is painted with approach and departure
+    boustrophedon, ///< hatch segments of monotone cells are painted by zigzags joined in contact where possible
+    offset         ///< region is painted by contours offset inside by step and joined in contact into spiral
+  };
+
   /**
    * @brief Robot configuration representation class
    *
@@ -30,6 +53,11 @@ namespace srm {
       accuracy,               ///< robot accuracy
       pouringStep;            ///< step for pouring
     std::string programName;  ///< name of robot program
+    sampling_t sampling = sampling_t::chord;  ///< curve sampling mode
+    hatching_t hatching = hatching_t::lines;  ///< fill hatching mode
+    std::map<std::string, hatching_t>
+      idsHatching,                            ///< fill hatching modes of elements by id
+      classesHatching;                        ///< fill hatching modes of elements by class
 
   public:
     /**
@@ -62,12 +90,39 @@ namespace srm {
      */
     double GetSvgAcc(void) const noexcept;
 
+    /**
+     * Get curve sampling mode function.
+     * @return sampling mode
+     */
+    sampling_t GetSampling(void) const noexcept;
+
+    /**
+     * Get fill hatching mode function.
+     * @return hatching mode
+     */
+    hatching_t GetHatching(void) const noexcept;
+
+    /**
+     * Get fill hatching mode of element function. Mode set for id is used first, then mode of the first class
+     * with set mode, then common mode
+     * @param[in] id id of element (may be empty)
+     * @param[in] classes space separated classes of element (may be empty)
+     * @return hatching mode
+     */
+    hatching_t GetHatching(const std::string &id, const std::string &classes) const;
+
     /**
      * Get pouring step value function.
      * @return pouring step
      */
     double GetPouringStep(void) const noexcept;
 
+    /**
+     * Set pouring step value function.
+     * @param[in] step pouring step
+     */
+    void SetPouringStep(double step) noexcept;
+
     /**
      * Get program name function.
      * @return string wirh program name
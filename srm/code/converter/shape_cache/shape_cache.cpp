@@ -0,0 +1,72 @@
+/**
+ * @file
+ * @brief Shape template cache class source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains shape_cache_t class realisation to sample repeated circles and ellipses once per conversion
+ */
+
+#include <srm.h>
+
+#include <functional>
+
+/**
+ * Evaluate hash of key function
+ * @param[in] key cache key
+ * @return hash value
+ */
+size_t srm::shape_cache_t::key_hash_t::operator()(const key_t &key) const noexcept {
+  std::hash<double> hash;
+  size_t res = hash(key.axisX.x);
+  res = res * 31 + hash(key.axisX.y);
+  res = res * 31 + hash(key.axisY.x);
+  res = res * 31 + hash(key.axisY.y);
+  return res * 31 + hash(key.accuracy);
+}
+
+/**
+ * Add points of closed ellipse to the open primitive by template function
+ * @param[in] center ellipse center point
+ * @param[in] axisX semi-diameter of parameter 0
+ * @param[in] axisY semi-diameter of parameter pi / 2
+ * @param[in] accuracy sampling accuracy
+ * @param[in, out] geom geometry to add points
+ * @return true if template was taken from cache, false - if it was sampled now
+ * @see EllipseSampling
+ */
+bool srm::shape_cache_t::AddEllipse(vec_t center, vec_t axisX, vec_t axisY, double accuracy, geometry_t *geom) {
+  key_t key{axisX, axisY, accuracy};
+  auto found = indices.find(key);
+  bool isHit = found != indices.end();
+
+  size_t prim;
+  if (isHit)
+    prim = found->second;
+  else {
+    EllipseSampling(vec_t(0, 0), axisX, axisY, accuracy, &outlines);
+    outlines.Close();
+    prim = outlines.Size() - 1;
+    indices.emplace(key, prim);
+  }
+
+  size_t
+    begin = outlines.Begin(prim),
+    size = outlines.End(prim) - begin,
+    first = geom->AddPlaceholders(size);
+  const double *tx = outlines.x.data() + begin, *ty = outlines.y.data() + begin;
+  double *x = geom->x.data() + first, *y = geom->y.data() + first;
+  for (size_t i = 0; i < size; i++) {
+    x[i] = center.x + tx[i];
+    y[i] = center.y + ty[i];
+  }
+  return isHit;
+}
+
+/**
+ * Remove all templates keeping capacity function
+ */
+void srm::shape_cache_t::Clear(void) noexcept {
+  indices.clear();
+  outlines.Clear();
+}
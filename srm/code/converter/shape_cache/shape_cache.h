@@ -0,0 +1,85 @@
+/**
+ * @file
+ * @brief Shape template cache class header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains shape_cache_t class description to sample repeated circles and ellipses once per conversion
+ */
+
+#pragma once
+
+#ifndef __SHAPE_CACHE_H_INCLUDED
+#define __SHAPE_CACHE_H_INCLUDED
+
+#include <cstddef>
+#include <unordered_map>
+#include "../defs.h"
+#include "../geometry/geometry.h"
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * @brief Shape template cache class
+   *
+   * Sampled outline of ellipse depends only on its semi-diameters and accuracy, so it is sampled once around origin
+   * and every next ellipse with the same key is got by translation of the template
+   */
+  class shape_cache_t {
+  private:
+    /**
+     * @brief Cache key struct
+     */
+    struct key_t {
+      vec_t
+        axisX,     ///< semi-diameter of parameter 0
+        axisY;     ///< semi-diameter of parameter pi / 2
+      double accuracy;  ///< sampling accuracy
+
+      /**
+       * == operator function
+       * @param[in] key key to compare with
+       * @return true if keys are equal, false - otherwise
+       */
+      bool operator==(const key_t &key) const noexcept {
+        return axisX.x == key.axisX.x && axisX.y == key.axisX.y && axisY.x == key.axisY.x && axisY.y == key.axisY.y &&
+          accuracy == key.accuracy;
+      }
+    };
+
+    /**
+     * @brief Cache key hash struct
+     */
+    struct key_hash_t {
+      /**
+       * Evaluate hash of key function
+       * @param[in] key cache key
+       * @return hash value
+       */
+      size_t operator()(const key_t &key) const noexcept;
+    };
+
+    std::unordered_map<key_t, size_t, key_hash_t> indices;  ///< index of template primitive by key
+    geometry_t outlines;                                      ///< templates centred in origin
+
+  public:
+    /**
+     * Add points of closed ellipse to the open primitive by template function
+     * @param[in] center ellipse center point
+     * @param[in] axisX semi-diameter of parameter 0
+     * @param[in] axisY semi-diameter of parameter pi / 2
+     * @param[in] accuracy sampling accuracy
+     * @param[in, out] geom geometry to add points
+     * @return true if template was taken from cache, false - if it was sampled now
+     * @see EllipseSampling
+     */
+    bool AddEllipse(vec_t center, vec_t axisX, vec_t axisY, double accuracy, geometry_t *geom);
+
+    /**
+     * Remove all templates keeping capacity function
+     */
+    void Clear(void) noexcept;
+  };
+}
+
+#endif /* __SHAPE_CACHE_H_INCLUDED */
@@ -9,269 +9,293 @@
 
 #include <srm.h>
 
+#include <algorithm>
+
 /**
- * Is point inside coordinate system evaluation function
- * @param[in] point point to evaluate
- * @param[in] width svg width
- * @param[in] height svg height
- * @return true if is inside, false - otherwise
+ * @brief Outcode bits of point position relative to svg borders
  */
-static bool _isInside(srm::vec_t point, double width, double height) noexcept {
-  if (point.x < 0 || point.y < 0 || point.x > width || point.y > height)
-    return false;
-  return true;
-}
-
-/** \brief Project namespace */
-namespace srm {
-  /** \brief Split primitives file namespace */
-  namespace spf {
-    /**
-     * @brief Line segment representation type
-     *
-     * Struct to save line segment with point and dir
-     */
-    struct line_segm_t {
-    public:
-      vec_t
-        point,  ///< start point
-        dir;    ///< direction vector
+enum outcode_t : unsigned {
+  inside = 0,  ///< point is in borders
+  left = 1,    ///< x < 0
+  right = 2,   ///< x > width
+  bottom = 4,  ///< y < 0
+  top = 8      ///< y > height
+};
 
-      /**
-       * 2 line segments intersection function
-       * @param[in] ls line segment to intersec
-       * @return 2 parametres of intersection
-       */
-      std::pair<double, double> Intersec(const line_segm_t &ls) const {
-        double delta = math::det<double>(dir, -ls.dir);
-        if (delta == 0)
-          throw std::exception("Line segments are parallel");
-        vec_t pointDelta = ls.point - point;
-        double
-          delta1 = math::det<double>(pointDelta, -ls.dir),
-          delta2 = math::det<double>(dir, pointDelta);
-        return std::pair<double, double>(delta1 / delta, delta2 / delta);
-      }
-    };
-
-    /**
-     * @brief Svg coordinate system representation class
-     *
-     * Class to save svg coordinate system bar for intersections
-     */
-    class svg_cs_t {
-    private:
-      line_segm_t barSegms[4];  ///< line segments of cs bar
+/**
+ * Get outcode of point function
+ * @param[in] x, y point coordinates
+ * @param[in] w width of svg
+ * @param[in] h height of svg
+ * @return outcode (combination of outcode_t bits)
+ */
+static unsigned _getOutcode(double x, double y, double w, double h) noexcept {
+  return (unsigned)(x < 0) * left | (unsigned)(x > w) * right | (unsigned)(y < 0) * bottom | (unsigned)(y > h) * top;
+}
 
-    public:
-      /**
-       * Class constructor by image parametres
-       * @param[in] w svg width
-       * @param[in] h svg height
-       */
-      svg_cs_t(double w, double h) {
-        if (w <= 0 || h <= 0)
-          throw std::exception("Incorrect w and h");
-        barSegms[0] = {{0, 0}, {0, h}};
-        barSegms[1] = {{0, h}, {w, 0}};
-        barSegms[2] = {{w, h}, {0, -h}};
-        barSegms[3] = {{w, 0}, {-w, 0}};
-      }
+/**
+ * Clip line segment by svg borders function (Liang-Barsky algorithm)
+ * @param[in] p0 start of segment
+ * @param[in] p1 end of segment
+ * @param[in] w width of svg
+ * @param[in] h height of svg
+ * @param[out] tIn parameter of segment entry to borders
+ * @param[out] tOut parameter of segment exit from borders
+ * @return true if segment intersects borders, false - otherwise
+ */
+static bool _clipSegment(srm::vec_t p0, srm::vec_t p1, double w, double h, double *tIn, double *tOut) noexcept {
+  srm::vec_t d = p1 - p0;
+  // segment point p0 + d * t is inside while p[i] * t <= q[i] for all borders
+  const double
+    p[4] = {-d.x, d.x, -d.y, d.y},
+    q[4] = {p0.x, w - p0.x, p0.y, h - p0.y};
 
-      /**
-       * Intersection between cs bar and linesegment function
-       * @param[in] ls line segment to intersec
-       * @return point of intersection (size may be 0, 1, 2)
-       */
-      std::vector<vec_t> Intersec(const line_segm_t &ls) const {
-        bool isFirstPoint = 0;
-        bool isParallelY = 0;
-        std::pair<double, vec_t> firstPoint;
-        // ort j
-        try {
-          auto [t1, t2] = ls.Intersec(barSegms[0]);
-          if (t1 >= 0 && t1 <= 1 && t2 >= 0 && t2 <= 1) {
-            isFirstPoint = 1;
-            firstPoint = {t1, ls.point + ls.dir * t1};
-          }
-        }
-        catch (std::exception&) {
-          isParallelY = 1;
-        }
-        if (!isParallelY) {
-          auto [t1, t2] = ls.Intersec(barSegms[2]);
-          if (isFirstPoint && t1 >= 0 && t1 <= 1 && t2 >= 0 && t2 <= 1) {
-            if (t1 > firstPoint.first)
-              return {firstPoint.second, ls.point + ls.dir * t1};
-            return {ls.point + ls.dir * t1, firstPoint.second};
-          }
-          else if (!isFirstPoint && t1 >= 0 && t1 <= 1 && t2 >= 0 && t2 <= 1) {
-            isFirstPoint = 1;
-            firstPoint = {t1, ls.point + ls.dir * t1};
-          }
-        }
-        // ort i
-        bool isParallelX = 0;
-        try {
-          auto [t1, t2] = ls.Intersec(barSegms[1]);
-          if (isFirstPoint && t1 >= 0 && t1 <= 1 && t2 >= 0 && t2 <= 1) {
-            if (t1 > firstPoint.first)
-              return {firstPoint.second, ls.point + ls.dir * t1};
-            return {ls.point + ls.dir * t1, firstPoint.second};
-          }
-          else if (!isFirstPoint && t1 >= 0 && t1 <= 1 && t2 >= 0 && t2 <= 1) {
-            isFirstPoint = 1;
-            firstPoint = {t1, ls.point + ls.dir * t1};
-          }
-        }
-        catch (std::exception &) {
-          isParallelX = 1;
-        }
-        if (!isParallelX) {
-          auto [t1, t2] = ls.Intersec(barSegms[3]);
-          if (isFirstPoint && t1 >= 0 && t1 <= 1 && t2 >= 0 && t2 <= 1) {
-            if (t1 > firstPoint.first) {
-              std::vector<vec_t> res(2);
-              res[0] = firstPoint.second;
-              res[1] = ls.point + ls.dir * t1;
-              return {firstPoint.second, ls.point + ls.dir * t1};
-            }
-            return {ls.point + ls.dir * t1, firstPoint.second};
-          }
-          else if (!isFirstPoint && t1 >= 0 && t1 <= 1 && t2 >= 0 && t2 <= 1) {
-            isFirstPoint = 1;
-            firstPoint = {t1, ls.point + ls.dir * t1};
-          }
-        }
-        
-        if (isFirstPoint)
-          return {firstPoint.second};
-        return {};
-      }
-    };
+  double t0 = 0, t1 = 1;
+  for (int i = 0; i < 4; i++) {
+    if (p[i] == 0) {
+      // segment is parallel to border and is out of it
+      if (q[i] < 0)
+        return false;
+      continue;
+    }
+    double t = q[i] / p[i];
+    if (p[i] < 0)
+      t0 = std::max(t0, t);
+    else
+      t1 = std::min(t1, t);
   }
+  *tIn = t0;
+  *tOut = t1;
+  return t0 <= t1;
 }
 
 /**
- * Define is point in borders function
- * @param[in] point point to define
+ * Get point of segment clipped by svg borders function
+ * @param[in] p0 start of segment
+ * @param[in] p1 end of segment
+ * @param[in] t parameter of point
  * @param[in] w width of svg
  * @param[in] h height of svg
- * @return true if in, false - otherwise
+ * @return point (rounding errors out of borders are removed)
  */
-static bool _isInBorders(srm::vec_t point, double w, double h) {
-  return point.x <= w && point.x >= 0 && point.y <= h && point.y >= 0;
+static srm::vec_t _getClipPoint(srm::vec_t p0, srm::vec_t p1, double t, double w, double h) noexcept {
+  srm::vec_t p = p0 + (p1 - p0) * t;
+  return srm::vec_t(std::clamp(p.x, 0.0, w), std::clamp(p.y, 0.0, h));
 }
 
 /**
- * Split primitive to list function
- * @param[in] prim primitive to split
- * @param[out] splitted splitted primitive
+ * Split primitive to pieces inside svg borders function
+ * @param[in] w width of svg
+ * @param[in] h height of svg
+ * @param[in] src geometry with primitive to split
+ * @param[in] prim index of primitive to split
+ * @param[out] pieces pieces of splitted primitive (is cleared)
  */
-static void _splitPrimitive(srm::primitive_t *prim, std::list<srm::primitive_t *> *splitted) {
-  auto *trans = srm::translator_t::GetPtr();
-  double w = trans->roboConf.GetW(), h = trans->roboConf.GetH();
-  srm::spf::svg_cs_t svgBar(w, h);
-  splitted->clear();
+static void _splitPrimitive(double w, double h, const srm::geometry_t &src, size_t prim, srm::geometry_t *pieces) {
+  pieces->Clear();
 
-  enum class point_place {
-    not_defined,
-    in,
-    out
-  } firstState = point_place::not_defined, prev = point_place::not_defined, cur = point_place::not_defined;
-  srm::vec_t prevP = prim->start;
-  if (_isInBorders(prevP, w, h)) {
-    prev = point_place::in;
-    splitted->push_back(new srm::primitive_t);
-    splitted->back()->start = prevP;
-  }
-  else
-    prev = point_place::out;
-  firstState = prev;
-  for (auto &point : *prim) {
-    if (_isInBorders(point.point, w, h))
-      cur = point_place::in;
-    else
-      cur = point_place::out;
+  size_t begin = src.Begin(prim), end = src.End(prim);
+  const double *x = src.x.data(), *y = src.y.data();
+  unsigned prevCode = _getOutcode(x[begin], y[begin], w, h);
+  if (prevCode == inside)
+    pieces->Add(x[begin], y[begin]);
 
-    if (cur == point_place::in && prev == point_place::in)
-      splitted->back()->push_back(srm::segment_t(point.point.x, point.point.y));
-    else if (cur == point_place::in && prev == point_place::out) {
-      splitted->push_back(new srm::primitive_t);
-      srm::spf::line_segm_t segm;
-      segm.point = prevP;
-      segm.dir = point.point - prevP;
-      auto intersec = svgBar.Intersec(segm);
-      splitted->back()->start = intersec[0];
-      splitted->back()->push_back(srm::segment_t(point.point.x, point.point.y));
-    }
-    else if (cur == point_place::out && prev == point_place::in) {
-      srm::spf::line_segm_t segm;
-      segm.point = prevP;
-      segm.dir = point.point - prevP;
-      auto intersec = svgBar.Intersec(segm);
-      splitted->back()->push_back(srm::segment_t(intersec.back().x, intersec.back().y));
-    }
-    else {
-      srm::spf::line_segm_t segm;
-      segm.point = prevP;
-      segm.dir = point.point - prevP;
-      auto intersec = svgBar.Intersec(segm);
+  for (size_t i = begin + 1; i < end; i++) {
+    unsigned code = _getOutcode(x[i], y[i], w, h);
+    // both points are inside
+    if ((prevCode | code) == inside)
+      pieces->Add(x[i], y[i]);
+    // segment may cross borders, it is clipped by Liang-Barsky
+    // (if both points are out of the same border, segment is outside and is skipped)
+    else if ((prevCode & code) == 0) {
+      srm::vec_t p0(x[i - 1], y[i - 1]), p1(x[i], y[i]);
+      double tIn, tOut;
+      bool isCrossed = _clipSegment(p0, p1, w, h, &tIn, &tOut);
 
-      if (intersec.size() == 2) {
-        splitted->push_back(new srm::primitive_t);
-        splitted->back()->start = intersec[0];
-        splitted->back()->push_back(srm::segment_t(intersec[1].x, intersec[1].y));
+      if (prevCode == inside) {
+        // segment leaves borders
+        if (isCrossed)
+          pieces->Add(_getClipPoint(p0, p1, tOut, w, h));
+      }
+      else if (code == inside) {
+        // segment enters borders
+        if (pieces->GetOpenSize() > 0)
+          pieces->Close();
+        if (isCrossed)
+          pieces->Add(_getClipPoint(p0, p1, tIn, w, h));
+        pieces->Add(p1);
+      }
+      else if (isCrossed && tIn < tOut) {
+        // segment crosses borders
+        if (pieces->GetOpenSize() > 0)
+          pieces->Close();
+        pieces->Add(_getClipPoint(p0, p1, tIn, w, h));
+        pieces->Add(_getClipPoint(p0, p1, tOut, w, h));
       }
     }
-    prev = cur;
-    prevP = point.point;
+    prevCode = code;
   }
-  if (prim->fill && firstState == point_place::in && splitted->size() > 1) {
-    for (auto point : *splitted->front())
-      splitted->back()->push_back(point);
-    delete splitted->front();
-    splitted->pop_front();
+  if (pieces->GetOpenSize() > 0)
+    pieces->Close();
+}
+
+/**
+ * Copy points of primitive to open primitive function
+ * @param[in] src geometry with primitive to copy
+ * @param[in] prim index of primitive
+ * @param[in] from offset of the first point to copy from the primitive start
+ * @param[out] dst geometry with open primitive
+ */
+static void _copyPoints(const srm::geometry_t &src, size_t prim, size_t from, srm::geometry_t *dst) {
+  dst->x.insert(dst->x.end(), src.x.begin() + src.Begin(prim) + from, src.x.begin() + src.End(prim));
+  dst->y.insert(dst->y.end(), src.y.begin() + src.Begin(prim) + from, src.y.begin() + src.End(prim));
+}
+
+/**
+ * Add vertex of clipped polygon to the open primitive function. Repeated vertices are skipped
+ * @param[in] px x coordinate
+ * @param[in] py y coordinate
+ * @param[in, out] dst geometry with open primitive
+ */
+static void _addVertex(double px, double py, srm::geometry_t *dst) {
+  if (dst->GetOpenSize() > 0 && dst->x.back() == px && dst->y.back() == py)
+    return;
+  dst->Add(px, py);
+}
+
+/**
+ * Clip polygon by one border function (one pass of Sutherland-Hodgman algorithm)
+ * @param[in] src geometry with polygon to clip
+ * @param[in] begin index of the first polygon vertex
+ * @param[in] end index after the last polygon vertex (polygon is closed implicitly)
+ * @param[in] isX true if border is vertical (bound is x coordinate), false - if it is horizontal
+ * @param[in] bound border coordinate
+ * @param[in] side 1 if inside points are not greater than bound, -1 - if they are not less
+ * @param[out] dst geometry to add vertices of clipped polygon to the open primitive
+ */
+static void _clipPolygon(const srm::geometry_t &src, size_t begin, size_t end, bool isX, double bound, double side,
+  srm::geometry_t *dst) {
+  // c is coordinate across border, o - along it
+  const double *c = isX ? src.x.data() : src.y.data(), *o = isX ? src.y.data() : src.x.data();
+
+  size_t prev = end - 1;
+  bool isPrevIn = (c[prev] - bound) * side <= 0;
+  for (size_t i = begin; i < end; i++) {
+    bool isIn = (c[i] - bound) * side <= 0;
+    // edge crosses border, its inside point lying on border is the crossing itself
+    if (isIn != isPrevIn && c[isIn ? i : prev] != bound) {
+      double cross = o[prev] + (o[i] - o[prev]) * ((bound - c[prev]) / (c[i] - c[prev]));
+      if (isX)
+        _addVertex(bound, cross, dst);
+      else
+        _addVertex(cross, bound, dst);
+    }
+    if (isIn)
+      _addVertex(src.x[i], src.y[i], dst);
+    prev = i;
+    isPrevIn = isIn;
+  }
+  // polygon is closed implicitly
+  size_t first = dst->GetOpenBegin();
+  if (dst->GetOpenSize() > 1 && dst->x[first] == dst->x.back() && dst->y[first] == dst->y.back()) {
+    dst->x.pop_back();
+    dst->y.pop_back();
   }
 }
 
 /**
- * Unite splitted fill primitive function
- * @param[out] splitted splitted primitive
+ * Clip fill primitive as polygon by svg borders function
+ * @param[in] w width of svg
+ * @param[in] h height of svg
+ * @param[in] src geometry with primitive to clip
+ * @param[in] prim index of primitive to clip
+ * @param[in] flags flags of clipped primitive
+ * @param[out] pieces scratch geometry for intermediate polygons (is cleared)
+ * @param[out] dst geometry without open primitive to add closed clipped primitive (nothing is added if polygon is empty)
+ * @return true if clipped primitive is added, false - otherwise
  */
-static void _unitePrimitives(std::list<srm::primitive_t *> *splitted) {
-  auto first = splitted->begin();
-  auto prim = first;
-  prim++;
-  while (prim != splitted->end()) {
-    (*first)->push_back(srm::segment_t((*prim)->start.x, (*prim)->start.y));
-    for (auto point : **prim)
-      (*first)->push_back(point);
-    prim++;
+static bool _clipFillPrimitive(double w, double h, const srm::geometry_t &src, size_t prim, uint8_t flags,
+  srm::geometry_t *pieces, srm::geometry_t *dst) {
+  // polygon is clipped by left, right, bottom and top borders in turn,
+  // passes write to scratch geometry and to the result open primitive by turns, so the last pass writes to the result
+  const struct {
+    bool isX;
+    double bound, side;
+  } borders[4] = {{true, 0, -1}, {true, w, 1}, {false, 0, -1}, {false, h, 1}};
+
+  pieces->Clear();
+  const srm::geometry_t *poly = &src;
+  size_t begin = src.Begin(prim), end = src.End(prim);
+  // the last point of closed primitive repeats the first vertex
+  if (src.flags[prim] & srm::geometry_t::closed)
+    end--;
+
+  for (int i = 0; i < 4; i++) {
+    srm::geometry_t *res = i % 2 == 0 ? pieces : dst;
+    // vertices of pass before previous are not needed
+    res->Discard();
+    _clipPolygon(*poly, begin, end, borders[i].isX, borders[i].bound, borders[i].side, res);
+    // polygon is out of borders (line segment is kept as contour of degenerate polygon)
+    if (res->GetOpenSize() < 2) {
+      res->Discard();
+      dst->Discard();
+      return false;
+    }
+    poly = res;
+    begin = res->GetOpenBegin();
+    end = res->x.size();
   }
-  prim = first;
-  for (prim++; prim != splitted->end(); prim++)
-    delete *prim;
-  splitted->erase(++first, splitted->end());
-  splitted->front()->fill = true;
-  srm::vec_t start = splitted->front()->start;
-  splitted->back()->push_back(srm::segment_t(start.x, start.y));
+  if (dst->GetOpenSize() > 2)
+    dst->Add(dst->GetPoint(dst->GetOpenBegin()));
+  dst->Close(flags);
+  return true;
 }
 
 /**
- * Split primitives in list function
- * @param[out] prims primitive to split
+ * Split primitives by svg borders function
+ * @param[in, out] ctx conversion context
+ * @param[in] src geometry to split
+ * @param[out] dst geometry to add splitted primitives (is not cleared)
  */
-void srm::SplitPrimitives(std::list<primitive_t *> *prims) {
-  auto prim = prims->begin();
-  while (prim != prims->end()) {
-    std::list<primitive_t *> splittedPrim;
-    _splitPrimitive(*prim, &splittedPrim);
-    if ((*prim)->fill)
-      _unitePrimitives(&splittedPrim);
-    for (auto &sPrim : splittedPrim)
-      prims->insert(prim, sPrim);
-    delete *prim;
-    prim = prims->erase(prim);
+void srm::SplitPrimitives(conversion_context_t *ctx, const geometry_t &src, geometry_t *dst) {
+  double w = ctx->roboConf.GetW(), h = ctx->roboConf.GetH();
+  geometry_t &pieces = ctx->pieces;
+  // true if a contour of the current fill region is already added
+  bool isRegionOpen = false;
+
+  for (size_t prim = 0; prim < src.Size(); prim++) {
+    const bbox_t &bbox = src.bboxes[prim];
+    uint8_t flags = src.flags[prim] &
+      (geometry_t::fill | geometry_t::evenOdd | geometry_t::boustrophedon | geometry_t::offset);
+    if (!(src.flags[prim] & geometry_t::subpath))
+      isRegionOpen = false;
+    // contours of region clipped away are skipped, so subpath flag is set by added contours only
+    if ((flags & geometry_t::fill) && isRegionOpen)
+      flags |= geometry_t::subpath;
+    // primitive is completely out of borders
+    if (bbox.IsOut(w, h))
+      continue;
+    // primitive is completely inside borders, so it is the only piece of itself
+    if (bbox.min.x >= 0 && bbox.min.y >= 0 && bbox.max.x <= w && bbox.max.y <= h) {
+      _copyPoints(src, prim, 0, dst);
+      // fill primitive is closed as clipped polygons are
+      if ((src.flags[prim] & geometry_t::fill) && !(src.flags[prim] & geometry_t::closed))
+        dst->Add(src.GetPoint(src.Begin(prim)));
+      dst->Close(flags);
+      isRegionOpen = (flags & geometry_t::fill) != 0;
+      continue;
+    }
+
+    // fill primitives are clipped as polygons to keep them closed, strokes are splitted to pieces
+    if (src.flags[prim] & geometry_t::fill) {
+      if (_clipFillPrimitive(w, h, src, prim, flags, &pieces, dst))
+        isRegionOpen = true;
+      continue;
+    }
+    _splitPrimitive(w, h, src, prim, &pieces);
+    for (size_t i = 0; i < pieces.Size(); i++) {
+      _copyPoints(pieces, i, 0, dst);
+      dst->Close();
+    }
   }
 }
@@ -12,16 +12,17 @@
 #ifndef __SPLIT_PRIMS_H_INCLUDED
 #define __SPLIT_PRIMS_H_INCLUDED
 
-#include <list>
-#include "../primitive/primitive.h"
+#include "../geometry/geometry.h"
 
 /** \brief Project namespace */
 namespace srm {
   /**
-   * Split primitives in list function
-   * @param[out] prims primitive to split
+   * Split primitives by svg borders function
+   * @param[in, out] ctx conversion context
+   * @param[in] src geometry to split
+   * @param[out] dst geometry to add splitted primitives (is not cleared)
    */
-  void SplitPrimitives(std::list<primitive_t *> *prims);
+  void SplitPrimitives(conversion_context_t *ctx, const geometry_t &src, geometry_t *dst);
 }
 
 #endif /* __SPLIT_PRIMS_H_INCLUDED */
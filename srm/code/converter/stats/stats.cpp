@@ -0,0 +1,57 @@
+/**
+ * @file
+ * @brief Conversion statistics source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains stats_t struct realisation to collect conversion statistics
+ */
+
+#include <srm.h>
+
+/**
+ * Reset all counters function
+ */
+void srm::stats_t::Clear(void) noexcept {
+  *this = stats_t();
+}
+
+/**
+ * Add counters of other statistics function
+ * @param[in] stats statistics to add
+ * @return each self
+ */
+srm::stats_t & srm::stats_t::operator+=(const stats_t &stats) noexcept {
+  primitives += stats.primitives;
+  segments += stats.segments;
+  shapes += stats.shapes;
+  shapeHits += stats.shapeHits;
+  culledElements += stats.culledElements;
+  culledCurves += stats.culledCurves;
+  culledPoints += stats.culledPoints;
+  savedDeparts += stats.savedDeparts;
+  fillTimeSaved += stats.fillTimeSaved;
+  return *this;
+}
+
+/**
+ * Write statistics to output stream
+ * @param[in] out output stream
+ * @param[in] stats statistics to write
+ * @return ostream variable
+ */
+std::ostream & srm::operator<<(std::ostream &out, const stats_t &stats) {
+  out << "primitives: " << stats.primitives << ", segments: " << stats.segments;
+  if (stats.shapes != 0)
+    out << ", shape cache hits: " << stats.shapeHits << "/" << stats.shapes << " (" <<
+      stats.shapeHits * 100 / stats.shapes << "%)";
+  if (stats.culledElements != 0 || stats.culledCurves != 0)
+    out << ", culled out of sheet: " << stats.culledElements << " elements, " << stats.culledCurves << " curves";
+  if (stats.culledPoints != 0)
+    out << ", " << stats.culledPoints << " points";
+  if (stats.savedDeparts != 0)
+    out << ", fill departures saved: " << stats.savedDeparts;
+  if (stats.fillTimeSaved != 0)
+    out << ", hatch angles save: " << stats.fillTimeSaved << " s";
+  return out;
+}
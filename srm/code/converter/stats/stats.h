@@ -0,0 +1,59 @@
+/**
+ * @file
+ * @brief Conversion statistics header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains stats_t struct description to collect conversion statistics
+ */
+
+#pragma once
+
+#ifndef __STATS_H_INCLUDED
+#define __STATS_H_INCLUDED
+
+#include <cstddef>
+#include <ostream>
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * @brief Conversion statistics struct
+   *
+   * Counters collected during conversion of one document
+   */
+  struct stats_t {
+    size_t
+      primitives = 0,      ///< number of written primitives
+      segments = 0,        ///< number of written motion segments (including fill)
+      shapes = 0,          ///< number of sampled circles and ellipses
+      shapeHits = 0,       ///< number of circles and ellipses taken from shape cache
+      culledElements = 0,  ///< number of elements skipped before sampling as out of sheet
+      culledCurves = 0,    ///< number of path curves and arcs out of sheet replaced by chords
+      culledPoints = 0,    ///< number of points of polylines, polygons and paths discarded as out of sheet
+      savedDeparts = 0;    ///< number of fill departures replaced by moves in contact
+    double fillTimeSaved = 0;  ///< estimated robot time saved by choice of hatch angles, s
+
+    /**
+     * Reset all counters function
+     */
+    void Clear(void) noexcept;
+
+    /**
+     * Add counters of other statistics function
+     * @param[in] stats statistics to add
+     * @return each self
+     */
+    stats_t & operator+=(const stats_t &stats) noexcept;
+  };
+
+  /**
+   * Write statistics to output stream
+   * @param[in] out output stream
+   * @param[in] stats statistics to write
+   * @return ostream variable
+   */
+  std::ostream & operator<<(std::ostream &out, const stats_t &stats);
+}
+
+#endif /* __STATS_H_INCLUDED */
@@ -0,0 +1,204 @@
+/**
+ * @file
+ * @brief Svg file loading class source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains svg_file_t class realisation to load svg file for in-situ parsing
+ */
+
+#include <srm.h>
+
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Default constructor
+ */
+srm::svg_file_t::svg_file_t(void) noexcept : data(nullptr), size(0), storage(storage_t::none) {
+}
+
+/**
+ * Move constructor
+ * @param[in] file file to move data from
+ */
+srm::svg_file_t::svg_file_t(svg_file_t &&file) noexcept : data(file.data), size(file.size), storage(file.storage) {
+  file.data = nullptr;
+  file.size = 0;
+  file.storage = storage_t::none;
+}
+
+/**
+ * Move assignment operator
+ * @param[in] file file to move data from
+ * @return each self
+ */
+srm::svg_file_t & srm::svg_file_t::operator=(svg_file_t &&file) noexcept {
+  if (this != &file) {
+    Close();
+    data = file.data;
+    size = file.size;
+    storage = file.storage;
+    file.data = nullptr;
+    file.size = 0;
+    file.storage = storage_t::none;
+  }
+  return *this;
+}
+
+/**
+ * Try to map file in memory function
+ * @param[in] fileName file name
+ * @return true if file was mapped, false - otherwise
+ */
+bool srm::svg_file_t::Map(const std::string &fileName) {
+  // mapping is zero filled up to the end of last page, so terminating zero is free
+  // only if file size is not multiple of page size
+#ifdef _WIN32
+  SYSTEM_INFO sysInfo;
+  GetSystemInfo(&sysInfo);
+
+  HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    throw std::exception("Failed to open intput file");
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0 ||
+    (unsigned long long)fileSize.QuadPart % sysInfo.dwPageSize == 0 ||
+    (unsigned long long)fileSize.QuadPart > (size_t)-1) {
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+  CloseHandle(file);
+  if (mapping == NULL)
+    return false;
+  void *view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+  // view keeps mapping object alive
+  CloseHandle(mapping);
+  if (view == NULL)
+    return false;
+
+  data = static_cast<char *>(view);
+  size = (size_t)fileSize.QuadPart;
+#else
+  int file = open(fileName.c_str(), O_RDONLY);
+  if (file < 0)
+    throw std::exception("Failed to open intput file");
+
+  struct stat fileStat;
+  long pageSize = sysconf(_SC_PAGESIZE);
+  if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0 || pageSize <= 0 ||
+    fileStat.st_size % pageSize == 0) {
+    close(file);
+    return false;
+  }
+
+  void *view = mmap(NULL, (size_t)fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+  close(file);
+  if (view == MAP_FAILED)
+    return false;
+  madvise(view, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+
+  data = static_cast<char *>(view);
+  size = (size_t)fileStat.st_size;
+#endif
+  storage = storage_t::mapping;
+  return true;
+}
+
+/**
+ * Read whole file into heap buffer function
+ * @param[in] fileName file name
+ */
+void srm::svg_file_t::Read(const std::string &fileName) {
+  std::ifstream fin(fileName, std::ios::binary | std::ios::ate);
+  if (!fin.is_open())
+    throw std::exception("Failed to open intput file");
+
+  std::streamoff fileSize = fin.tellg();
+  if (fileSize < 0)
+    throw std::exception("Failed to read intput file");
+  fin.seekg(0);
+
+  data = new char[(size_t)fileSize + 1];
+  storage = storage_t::heap;
+  size = (size_t)fileSize;
+  if (!fin.read(data, fileSize)) {
+    Close();
+    throw std::exception("Failed to read intput file");
+  }
+  data[size] = 0;
+}
+
+/**
+ * Load file function
+ * @param[in] fileName file name
+ * @param[in] useMapping true to try memory mapping first, false to read file into heap buffer
+ */
+void srm::svg_file_t::Load(const std::string &fileName, bool useMapping) {
+  Close();
+  if (!useMapping || !Map(fileName))
+    Read(fileName);
+}
+
+/**
+ * Free loaded data function
+ */
+void srm::svg_file_t::Close(void) noexcept {
+  if (storage == storage_t::mapping) {
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(data, size);
+#endif
+  }
+  else if (storage == storage_t::heap)
+    delete[] data;
+  data = nullptr;
+  size = 0;
+  storage = storage_t::none;
+}
+
+/**
+ * Get zero terminated writable file data function
+ * @return pointer to data (nullptr if nothing is loaded)
+ */
+char * srm::svg_file_t::GetData(void) const noexcept {
+  return data;
+}
+
+/**
+ * Get file size function
+ * @return file size in bytes
+ */
+size_t srm::svg_file_t::GetSize(void) const noexcept {
+  return size;
+}
+
+/**
+ * Is file mapped in memory function
+ * @return true if mapped, false - otherwise
+ */
+bool srm::svg_file_t::IsMapped(void) const noexcept {
+  return storage == storage_t::mapping;
+}
+
+/**
+ * Class destructor
+ */
+srm::svg_file_t::~svg_file_t(void) noexcept {
+  Close();
+}
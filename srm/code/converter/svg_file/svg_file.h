@@ -0,0 +1,114 @@
+/**
+ * @file
+ * @brief Svg file loading class header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains svg_file_t class description to load svg file for in-situ parsing
+ */
+
+#pragma once
+
+#ifndef __SVG_FILE_H_INCLUDED
+#define __SVG_FILE_H_INCLUDED
+
+#include <string>
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * @brief Svg file loading class
+   *
+   * Loads file into one zero terminated writable buffer for rapidxml in-situ parsing.
+   * Private copy-on-write mapping is used if it is possible, single read into heap buffer otherwise.
+   */
+  class svg_file_t {
+  private:
+    /**
+     * @brief Buffer storage type
+     *
+     * Contains possible places of file data
+     */
+    enum class storage_t {
+      none,     ///< nothing is loaded
+      mapping,  ///< private copy-on-write file mapping
+      heap      ///< heap buffer
+    };
+
+    char *data;         ///< zero terminated file data
+    size_t size;        ///< file size in bytes (without terminating zero)
+    storage_t storage;  ///< storage type of data
+
+    /**
+     * Try to map file in memory function
+     * @param[in] fileName file name
+     * @return true if file was mapped, false - otherwise
+     */
+    bool Map(const std::string &fileName);
+
+    /**
+     * Read whole file into heap buffer function
+     * @param[in] fileName file name
+     */
+    void Read(const std::string &fileName);
+
+  public:
+    /**
+     * Default constructor
+     */
+    svg_file_t(void) noexcept;
+
+    svg_file_t(const svg_file_t &) = delete;
+    svg_file_t & operator=(const svg_file_t &) = delete;
+
+    /**
+     * Move constructor
+     * @param[in] file file to move data from
+     */
+    svg_file_t(svg_file_t &&file) noexcept;
+
+    /**
+     * Move assignment operator
+     * @param[in] file file to move data from
+     * @return each self
+     */
+    svg_file_t & operator=(svg_file_t &&file) noexcept;
+
+    /**
+     * Load file function
+     * @param[in] fileName file name
+     * @param[in] useMapping true to try memory mapping first, false to read file into heap buffer
+     */
+    void Load(const std::string &fileName, bool useMapping = true);
+
+    /**
+     * Free loaded data function
+     */
+    void Close(void) noexcept;
+
+    /**
+     * Get zero terminated writable file data function
+     * @return pointer to data (nullptr if nothing is loaded)
+     */
+    char * GetData(void) const noexcept;
+
+    /**
+     * Get file size function
+     * @return file size in bytes
+     */
+    size_t GetSize(void) const noexcept;
+
+    /**
+     * Is file mapped in memory function
+     * @return true if mapped, false - otherwise
+     */
+    bool IsMapped(void) const noexcept;
+
+    /**
+     * Class destructor
+     */
+    ~svg_file_t(void) noexcept;
+  };
+}
+
+#endif /* __SVG_FILE_H_INCLUDED */
@@ -0,0 +1,216 @@
+/**
+ * @file
+ * @brief Streaming svg reader class source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains svg_stream_t class realisation to read svg elements without building full DOM
+ */
+
+#include <srm.h>
+
+#include <cctype>
+#include <cstring>
+
+/**
+ * Constructor for svg_stream_t
+ * @param[in] svgFileName svg file name
+ */
+srm::svg_stream_t::svg_stream_t(const std::string &svgFileName) :
+  fin(svgFileName, std::ios::binary), pos(0), end(0), isEof(false), level(0) {
+  const size_t chunkSize = 64 * 1024;
+
+  if (!fin.is_open())
+    throw std::exception("Failed to open intput file");
+  buf.resize(chunkSize);
+}
+
+/**
+ * Ensure at least n bytes are read from current token position function
+ * @param[in] n number of bytes
+ * @return true if bytes are available, false if file is ended before
+ */
+bool srm::svg_stream_t::Ensure(size_t n) {
+  if (pos + n <= end)
+    return true;
+  if (isEof)
+    return false;
+
+  // move current token to the buffer start
+  if (pos > 0) {
+    memmove(buf.data(), buf.data() + pos, end - pos);
+    end -= pos;
+    pos = 0;
+  }
+  while (end < n && !isEof) {
+    // token is larger than buffer
+    if (end == buf.size())
+      buf.resize(buf.size() * 2);
+    fin.read(buf.data() + end, buf.size() - end);
+    size_t count = (size_t)fin.gcount();
+    if (count == 0)
+      isEof = true;
+    end += count;
+  }
+  return end >= n;
+}
+
+/**
+ * Find pattern from current token position function
+ * @param[in] from offset from current token position to start search
+ * @param[in] pattern pattern to find
+ * @return offset of pattern from current token position
+ */
+size_t srm::svg_stream_t::Find(size_t from, const char *pattern) {
+  size_t len = strlen(pattern);
+
+  for (size_t i = from; ; i++) {
+    if (!Ensure(i + len))
+      throw std::exception("Error in the svg file");
+    if (memcmp(buf.data() + pos + i, pattern, len) == 0)
+      return i;
+  }
+}
+
+/**
+ * Find end of start or end tag respecting quoted attribute values function
+ * @return offset of '>' from current token position
+ */
+size_t srm::svg_stream_t::FindTagEnd(void) {
+  char quote = 0;
+
+  for (size_t i = 1; ; i++) {
+    if (!Ensure(i + 1))
+      throw std::exception("Error in the svg file");
+    char sym = buf[pos + i];
+    if (quote != 0) {
+      if (sym == quote)
+        quote = 0;
+    }
+    else if (sym == '"' || sym == '\'')
+      quote = sym;
+    else if (sym == '>')
+      return i;
+  }
+}
+
+/**
+ * Get name of tag from its text
+ * @param[in] str tag text after '<' or '</'
+ * @param[in] len length of text
+ * @return tag name
+ */
+static std::string _getTagName(const char *str, size_t len) {
+  size_t nameLen = 0;
+  while (nameLen < len && !isspace(static_cast<unsigned char>(str[nameLen])) &&
+    str[nameLen] != '/' && str[nameLen] != '>')
+    nameLen++;
+  return std::string(str, nameLen);
+}
+
+/**
+ * Process start tag function
+ * @param[in] len length of tag with brackets
+ * @param[in] onTag tag handler
+ */
+void srm::svg_stream_t::StartTag(size_t len, const std::function<void (const tag_t &)> &onTag) {
+  const char *str = buf.data() + pos;
+  bool isSelfClosing = str[len - 2] == '/';
+  std::string name = _getTagName(str + 1, len - 1);
+  bool isGroup = name == "g" || name == "svg";
+
+  // make single element document from start tag
+  tagString.assign(str, str + len);
+  if (!isSelfClosing) {
+    tagString.back() = '/';
+    tagString.push_back('>');
+  }
+  tagString.push_back(0);
+  tagDoc.clear();
+  try {
+    tagDoc.parse<rapidxml::parse_default>(tagString.data());
+  }
+  catch (rapidxml::parse_error err) {
+    throw std::exception("Error in the svg file");
+  }
+
+  tag_t tag(tagDoc.first_node());
+  tag.level = isGroup ? level + 1 : level;
+  onTag(tag);
+
+  if (!isSelfClosing) {
+    openedTags.push_back(name);
+    if (isGroup)
+      level++;
+  }
+}
+
+/**
+ * Process end tag function
+ * @param[in] len length of tag with brackets
+ */
+void srm::svg_stream_t::EndTag(size_t len) {
+  std::string name = _getTagName(buf.data() + pos + 2, len - 2);
+
+  if (openedTags.empty() || openedTags.back() != name)
+    throw std::exception("Error in the svg file");
+  openedTags.pop_back();
+  if (name == "g" || name == "svg")
+    level--;
+}
+
+/**
+ * Read whole file and call handler for each element in document order
+ * @param[in] onTag tag handler (tag node is valid only during call)
+ */
+void srm::svg_stream_t::Parse(const std::function<void (const tag_t &)> &onTag) {
+  while (Ensure(1)) {
+    // skip text
+    if (buf[pos] != '<') {
+      const char *next = static_cast<const char *>(memchr(buf.data() + pos, '<', end - pos));
+      pos = next == nullptr ? end : next - buf.data();
+      continue;
+    }
+
+    if (!Ensure(2))
+      throw std::exception("Error in the svg file");
+    char sym = buf[pos + 1];
+    if (sym == '!') {
+      if (Ensure(4) && memcmp(buf.data() + pos, "<!--", 4) == 0)
+        pos += Find(4, "-->") + 3;
+      else if (Ensure(9) && memcmp(buf.data() + pos, "<![CDATA[", 9) == 0)
+        pos += Find(9, "]]>") + 3;
+      else {
+        // doctype with possible internal subset
+        int depth = 0;
+        size_t i = 2;
+        for (; ; i++) {
+          if (!Ensure(i + 1))
+            throw std::exception("Error in the svg file");
+          if (buf[pos + i] == '[')
+            depth++;
+          else if (buf[pos + i] == ']')
+            depth--;
+          else if (buf[pos + i] == '>' && depth == 0)
+            break;
+        }
+        pos += i + 1;
+      }
+    }
+    else if (sym == '?')
+      pos += Find(2, "?>") + 2;
+    else if (sym == '/') {
+      size_t len = FindTagEnd() + 1;
+      EndTag(len);
+      pos += len;
+    }
+    else {
+      size_t len = FindTagEnd() + 1;
+      StartTag(len, onTag);
+      pos += len;
+    }
+  }
+
+  if (!openedTags.empty())
+    throw std::exception("Error in the svg file");
+}
@@ -0,0 +1,93 @@
+/**
+ * @file
+ * @brief Streaming svg reader class header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains svg_stream_t class description to read svg elements without building full DOM
+ */
+
+#pragma once
+
+#ifndef __SVG_STREAM_H_INCLUDED
+#define __SVG_STREAM_H_INCLUDED
+
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+#include "../rapidxml.hpp"
+#include "../tags_translator/tag/tag.h"
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * @brief Streaming svg reader class
+   *
+   * Event-driven tokenizer which reads svg file by chunks and calls handler for each element start tag.
+   * Memory is bounded by nesting depth and the largest single tag, not by document size.
+   */
+  class svg_stream_t {
+  private:
+    std::ifstream fin;                     ///< input file stream
+    std::vector<char> buf;                 ///< read buffer
+    size_t
+      pos,                                 ///< position of current token in buffer
+      end;                                 ///< end of read data in buffer
+    bool isEof;                            ///< true if whole file is read
+
+    std::vector<char> tagString;           ///< zero terminated copy of current start tag for rapidxml
+    rapidxml::xml_document<> tagDoc;       ///< one element document of current start tag
+    std::vector<std::string> openedTags;   ///< names of opened elements
+    unsigned level;                        ///< level by g and svg tags like in DOM traversal
+
+    /**
+     * Ensure at least n bytes are read from current token position function
+     * @param[in] n number of bytes
+     * @return true if bytes are available, false if file is ended before
+     */
+    bool Ensure(size_t n);
+
+    /**
+     * Find pattern from current token position function
+     * @param[in] from offset from current token position to start search
+     * @param[in] pattern pattern to find
+     * @return offset of pattern from current token position
+     */
+    size_t Find(size_t from, const char *pattern);
+
+    /**
+     * Find end of start or end tag respecting quoted attribute values function
+     * @return offset of '>' from current token position
+     */
+    size_t FindTagEnd(void);
+
+    /**
+     * Process start tag function
+     * @param[in] len length of tag with brackets
+     * @param[in] onTag tag handler
+     */
+    void StartTag(size_t len, const std::function<void (const tag_t &)> &onTag);
+
+    /**
+     * Process end tag function
+     * @param[in] len length of tag with brackets
+     */
+    void EndTag(size_t len);
+
+  public:
+    /**
+     * Constructor for svg_stream_t
+     * @param[in] svgFileName svg file name
+     */
+    svg_stream_t(const std::string &svgFileName);
+
+    /**
+     * Read whole file and call handler for each element in document order
+     * @param[in] onTag tag handler (tag node is valid only during call)
+     */
+    void Parse(const std::function<void (const tag_t &)> &onTag);
+  };
+}
+
+#endif /* __SVG_STREAM_H_INCLUDED */
@@ -9,60 +9,99 @@
 
 #include <srm.h>
 
+#include <algorithm>
+
+/**
+ * Get the biggest semi-axis of ellipse by its conjugate semi-diameters function
+ * @param[in] axisX semi-diameter of parameter 0
+ * @param[in] axisY semi-diameter of parameter pi / 2
+ * @return length of the biggest semi-axis (the biggest singular value of matrix [axisX axisY])
+ */
+static double _getMaxRadius(srm::vec_t axisX, srm::vec_t axisY) noexcept {
+  if (axisX.y == 0 && axisY.x == 0)
+    return std::max(fabs(axisX.x), fabs(axisY.y));
+  return sqrt(math::eigVal(axisX.Len2(), axisX.Dot(axisY), axisY.Len2()).second);
+}
+
+/**
+ * Get number of uniform parameter segments of ellipse arc function
+ * @param[in] maxRadius maximal radius of ellipse
+ * @param[in] angle parameter span of arc (not negative)
+ * @param[in] accuracy maximal length of segment
+ * @return number of segments (not less than 1)
+ */
+static size_t _getNumOfSegments(double maxRadius, double angle, double accuracy) noexcept {
+  const double maxNumOfSegments = 1 << 20;
+  // chord of parameter step d is not longer than 2 * sin(d / 2) * maxRadius on any part of ellipse,
+  // step is limited by quarter to keep the shape of ellipse for big accuracy
+  double maxStep = srm::pi / 2;
+  if (accuracy < 2 * maxRadius)
+    maxStep = std::min(maxStep, 2 * asin(accuracy / (2 * maxRadius)));
+  return (size_t)std::max(1.0, std::min(maxNumOfSegments, ceil(angle / maxStep)));
+}
+
+/**
+ * Write points of ellipse with uniform parameter step function. Sine and cosine are evaluated only for the first
+ * point and the step, next points are got by rotation
+ * @param[in] center ellipse center point
+ * @param[in] axisX semi-diameter of parameter 0
+ * @param[in] axisY semi-diameter of parameter pi / 2
+ * @param[in] param parameter of the first point
+ * @param[in] step parameter step
+ * @param[in] numOfPoints number of points
+ * @param[out] x, y coordinates of points
+ */
+static void _writePoints(srm::vec_t center, srm::vec_t axisX, srm::vec_t axisY, double param, double step,
+  size_t numOfPoints, double *x, double *y) noexcept {
+  double
+    co = cos(param), si = sin(param),
+    stepCo = cos(step), stepSi = sin(step);
+
+  for (size_t i = 0; i < numOfPoints; i++) {
+    x[i] = center.x + axisX.x * co + axisY.x * si;
+    y[i] = center.y + axisX.y * co + axisY.y * si;
+
+    double nextCo = co * stepCo - si * stepSi;
+    si = si * stepCo + co * stepSi;
+    co = nextCo;
+  }
+}
+
 /**
- * Ellipse sampling function
+ * Ellipse sampling function. Ellipse is set by conjugate semi-diameters, so affine image of any ellipse is sampled
+ * with accuracy in the final coordinates: points are center + axisX * cos(t) + axisY * sin(t)
  * @param[in] center ellipse center point
- * @param[in] radiuses 2 ellipse radiuses by x and y
+ * @param[in] axisX semi-diameter of parameter 0 (radius by x for not transformed ellipse)
+ * @param[in] axisY semi-diameter of parameter pi / 2 (radius by y for not transformed ellipse)
  * @param[in] accuracy sampling accuracy
- * @return point vector with sampling
+ * @param[in, out] geom geometry to add points of closed ellipse to the open primitive
  */
-std::vector<srm::vec_t> srm::EllipseSampling(vec_t center, vec_t radiuses, double accuracy) {
-  const double param0 = pi / 2;
-  if (radiuses.x <= 0 || radiuses.y <= 0)
-    throw std::exception("Incorrect radius in ellipse");
+void srm::EllipseSampling(vec_t center, vec_t axisX, vec_t axisY, double accuracy, geometry_t *geom) {
   if (accuracy <= 0)
     throw std::exception("Incorrect accuracy");
 
-  double accuracy2 = accuracy * accuracy, param = 2 * param0, angle0, dist2;
-  unsigned numOfPoints = 2;
-  vec_t p0;
-  if (radiuses.x > radiuses.y) {
-    p0.x += radiuses.x;
-    angle0 = 0;
-  }
-  else {
-    p0.y += radiuses.y;
-    angle0 = pi / 2;
-  }
+  size_t numOfSegments = _getNumOfSegments(_getMaxRadius(axisX, axisY), 2 * pi, accuracy);
+  size_t first = geom->AddPlaceholders(numOfSegments + 1);
+  double *x = geom->x.data() + first, *y = geom->y.data() + first;
 
-  do {
-    param /= 2;
-    numOfPoints *= 2;
-    double angle = angle0 + param;
-    dist2 = (vec_t(radiuses.x * cos(angle), radiuses.y * sin(angle)) - p0).Len2();
-  } while (dist2 > accuracy2);
-
-  std::vector<vec_t> res(numOfPoints + 1);
-  for (unsigned i = 0; i < numOfPoints; i++) {
-    double angle = 2 * pi * i / numOfPoints;
-    res[i] = vec_t(center.x + radiuses.x * cos(angle), center.y + radiuses.y * sin(angle));
-  }
-  res[numOfPoints] = res[0];
-  return res;
+  _writePoints(center, axisX, axisY, 0, 2 * pi / numOfSegments, numOfSegments, x, y);
+  x[numOfSegments] = x[0];
+  y[numOfSegments] = y[0];
 }
 
 /**
- * Ellipse arc from 'path' tag sampling function
+ * Get ellipse arc from 'path' tag arguments function (conversion from endpoint to center parametrisation)
  * @param[in] p1 first arc point
  * @param[in] p2 second arc point
- * @param[in] radiuses 2 ellipse radiuses by x and y
+ * @param[in] radiuses 2 ellipse radiuses by x and y (not zero)
  * @param[in] fA flag for arc angle size
  * @param[in] fS flag for angle delta
  * @param[in] phi angle
- * @param[in] accuracy sampling accuracy
- * @return point vector with sampling
+ * @param[in] transform transformation of arc to the final coordinates
+ * @return arc in the final coordinates
  */
-std::vector<srm::vec_t> srm::EllipseArcSampling(vec_t p1, vec_t p2, vec_t radiuses, bool fA, bool fS, double phi, double accuracy) {
+srm::ellipse_arc_t srm::GetEllipseArc(vec_t p1, vec_t p2, vec_t radiuses, bool fA, bool fS, double phi,
+  const transform_t &transform) noexcept {
   // evaluate center
   vec_t delta2 = (p1 - p2) / 2;
   double si = sin(phi), co = cos(phi);
@@ -72,58 +111,62 @@ std::vector<srm::vec_t> srm::EllipseArcSampling(vec_t p1, vec_t p2, vec_t radius
     radiuses *= sqrt(lambda);
   double
     tmp = radiuses.x * radiuses.x * p1s.y * p1s.y + radiuses.y * radiuses.y * p1s.x * p1s.x,
-    muler = sqrt((radiuses.x * radiuses.x * radiuses.y * radiuses.y - tmp) / tmp);
+    muler = sqrt(std::max(0.0, (radiuses.x * radiuses.x * radiuses.y * radiuses.y - tmp) / tmp));
   if (fA == fS)
     muler = -muler;
-  vec_t cs = vec_t(muler * radiuses.x * p1s.y / radiuses.y, muler * radiuses.y * p1s.x / radiuses.x);
+  vec_t cs = vec_t(muler * radiuses.x * p1s.y / radiuses.y, -muler * radiuses.y * p1s.x / radiuses.x);
   vec_t center = vec_t(co * cs.x - si * cs.y + (p1.x + p2.x) / 2, si * cs.x + co * cs.y + (p1.y + p2.y) / 2);
 
   // evaluate angles (parametres)
   vec_t
-    u = vec_t(1, 0),
-    v = vec_t((p1s.x - cs.x) / radiuses.x, (p1s.y - cs.y) / radiuses.y);
-  double param1 = acos(u.Dot(v) / u.Len() / v.Len());
-  if (u.Cross(v) < 0)
-    param1 = -param1;
-  u = v;
-  v = vec_t(-(p1s.x + cs.x) / radiuses.x, -(p1s.y + cs.y) / radiuses.y);
-  double paramDelta = acos(u.Dot(v) / u.Len() / v.Len()), param2 = param1;
-  if (u.Cross(v) < 0)
-    paramDelta = 2 * pi - paramDelta;
-  if (fS)
-    param2 += paramDelta;
-  else
-    param2 += paramDelta - 2 * pi;
-
-  // add fisrt 3 points
-  std::list<std::pair<double, vec_t>> sampling;
-  sampling.push_back(std::pair<double, vec_t>(param1, vec_t(center.x + radiuses.x * cos(param1), center.y + radiuses.y * sin(param1))));
-  double med = (param1 + param2) / 2;
-  sampling.push_back(std::pair<double, vec_t>(med, vec_t(center.x + radiuses.x * cos(med), center.y + radiuses.y * sin(med))));
-  sampling.push_back(std::pair<double, vec_t>(param2, vec_t(center.x + radiuses.x * cos(param2), center.y + radiuses.y * sin(param2))));
-
-  // sampling
-  auto cur = sampling.begin();
-  auto next = cur;
-  next++;
-  double accuracy2 = accuracy * accuracy;
-  while (next != sampling.end()) {
-    if ((cur->second - next->second).Len2() < accuracy2) {
-      cur = next;
-      next++;
-    }
-    else {
-      double med = (cur->first + next->first) / 2;
-      next = sampling.insert(next, std::pair<double, vec_t>(med, vec_t(center.x + radiuses.x * cos(med), center.y + radiuses.y * sin(med))));
-    }
-  }
+    u = vec_t((p1s.x - cs.x) / radiuses.x, (p1s.y - cs.y) / radiuses.y),
+    v = vec_t(-(p1s.x + cs.x) / radiuses.x, -(p1s.y + cs.y) / radiuses.y);
+  double param1 = atan2(u.y, u.x), paramDelta = atan2(u.Cross(v), u.Dot(v));
+  if (paramDelta < 0)
+    paramDelta += 2 * pi;
+  if (!fS)
+    paramDelta -= 2 * pi;
 
-  // create result vector
-  std::vector<vec_t> res(sampling.size());
-  cur = sampling.begin();
-  for (auto &vec : res) {
-    vec = cur->second;
-    cur++;
-  }
-  return res;
+  // parametrisation of arc is kept by affine transformation, only points and semi-diameters are transformed
+  ellipse_arc_t arc;
+  arc.start = transform.TransformPoint(p1);
+  arc.end = transform.TransformPoint(p2);
+  arc.center = transform.TransformPoint(center);
+  arc.axisX = transform.TransformVector(vec_t(co * radiuses.x, si * radiuses.x));
+  arc.axisY = transform.TransformVector(vec_t(-si * radiuses.y, co * radiuses.y));
+  arc.param = param1;
+  arc.paramDelta = paramDelta;
+  return arc;
+}
+
+/**
+ * Get bounding box of ellipse function
+ * @param[in] center ellipse center point
+ * @param[in] axisX semi-diameter of parameter 0
+ * @param[in] axisY semi-diameter of parameter pi / 2
+ * @return bounding box of the whole ellipse
+ */
+srm::bbox_t srm::GetEllipseBbox(vec_t center, vec_t axisX, vec_t axisY) noexcept {
+  // maximum of a * cos(t) + b * sin(t) is sqrt(a^2 + b^2)
+  vec_t extent(hypot(axisX.x, axisY.x), hypot(axisX.y, axisY.y));
+  return bbox_t{center - extent, center + extent};
+}
+
+/**
+ * Ellipse arc sampling function. Arc is sampled with accuracy in the final coordinates
+ * @param[in] arc ellipse arc in the final coordinates
+ * @param[in] accuracy sampling accuracy
+ * @param[in, out] geom geometry to add points of arc (from start to end) to the open primitive
+ */
+void srm::EllipseArcSampling(const ellipse_arc_t &arc, double accuracy, geometry_t *geom) {
+  // inner points are evaluated by rotation, end points are taken exactly
+  size_t numOfSegments = _getNumOfSegments(_getMaxRadius(arc.axisX, arc.axisY), fabs(arc.paramDelta), accuracy);
+  size_t first = geom->AddPlaceholders(numOfSegments + 1);
+  double *x = geom->x.data() + first, *y = geom->y.data() + first;
+
+  _writePoints(arc.center, arc.axisX, arc.axisY, arc.param, arc.paramDelta / numOfSegments, numOfSegments, x, y);
+  x[0] = arc.start.x;
+  y[0] = arc.start.y;
+  x[numOfSegments] = arc.end.x;
+  y[numOfSegments] = arc.end.y;
 }
@@ -12,32 +12,70 @@
 #ifndef __ELLIPSE_H_INCLUDED
 #define __ELLIPSE_H_INCLUDED
 
-#include <vector>
 #include "../../defs.h"
+#include "../../geometry/geometry.h"
+#include "../transform/transform.h"
 
 /** \brief Project namespace */
 namespace srm {
   /**
-   * Ellipse sampling function
+   * Ellipse sampling function. Ellipse is set by conjugate semi-diameters, so affine image of any ellipse is sampled
+   * with accuracy in the final coordinates: points are center + axisX * cos(t) + axisY * sin(t)
    * @param[in] center ellipse center point
-   * @param[in] radiuses 2 ellipse radiuses by x and y
+   * @param[in] axisX semi-diameter of parameter 0 (radius by x for not transformed ellipse)
+   * @param[in] axisY semi-diameter of parameter pi / 2 (radius by y for not transformed ellipse)
    * @param[in] accuracy sampling accuracy
-   * @return point vector with sampling
+   * @param[in, out] geom geometry to add points of closed ellipse to the open primitive
    */
-  std::vector<vec_t> EllipseSampling(vec_t center, vec_t radiuses, double accuracy);
+  void EllipseSampling(vec_t center, vec_t axisX, vec_t axisY, double accuracy, geometry_t *geom);
 
   /**
-   * Ellipse arc from 'path' tag sampling function
+   * @brief Ellipse arc in the final coordinates
+   *
+   * Points of arc are center + axisX * cos(t) + axisY * sin(t) for t from param to param + paramDelta
+   */
+  struct ellipse_arc_t {
+    vec_t
+      start,         ///< the first arc point
+      end,           ///< the last arc point
+      center,        ///< ellipse center point
+      axisX,         ///< semi-diameter of parameter 0
+      axisY;         ///< semi-diameter of parameter pi / 2
+    double
+      param,         ///< parameter of the first point
+      paramDelta;    ///< signed parameter span of arc
+  };
+
+  /**
+   * Get ellipse arc from 'path' tag arguments function (conversion from endpoint to center parametrisation)
    * @param[in] p1 first arc point
    * @param[in] p2 second arc point
-   * @param[in] radiuses 2 ellipse radiuses by x and y
+   * @param[in] radiuses 2 ellipse radiuses by x and y (not zero)
    * @param[in] fA flag for arc angle size
    * @param[in] fS flag for angle delta
    * @param[in] phi angle
+   * @param[in] transform transformation of arc to the final coordinates
+   * @return arc in the final coordinates
+   */
+  ellipse_arc_t GetEllipseArc(vec_t p1, vec_t p2, vec_t radiuses, bool fA, bool fS, double phi,
+    const transform_t &transform) noexcept;
+
+  /**
+   * Get bounding box of ellipse function
+   * @param[in] center ellipse center point
+   * @param[in] axisX semi-diameter of parameter 0
+   * @param[in] axisY semi-diameter of parameter pi / 2
+   * @return bounding box of the whole ellipse
+   */
+  bbox_t GetEllipseBbox(vec_t center, vec_t axisX, vec_t axisY) noexcept;
+
+  /**
+   * Ellipse arc sampling function. Arc is sampled with accuracy in the final coordinates
+   * @param[in] arc ellipse arc in the final coordinates
    * @param[in] accuracy sampling accuracy
-   * @return point vector with sampling
+   * @param[in, out] geom geometry to add points of arc (from start to end) to the open primitive
    */
-  std::vector<vec_t> EllipseArcSampling(vec_t p1, vec_t p2, vec_t radiuses, bool fA, bool fS, double phi, double accuracy);
+  void EllipseArcSampling(const ellipse_arc_t &arc, double accuracy, geometry_t *geom);
 }
 
 #endif /* __ELLIPSE_H_INCLUDED */
@@ -12,8 +12,13 @@
 #ifndef __BEZIER_H_INCLUDED
 #define __BEZIER_H_INCLUDED
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <exception>
 #include <vector>
 #include "../../../defs.h"
+#include "../../../geometry/geometry.h"
 
 /** \brief Project namespace */
 namespace srm {
@@ -49,6 +54,173 @@ namespace srm {
      */
     std::vector<vec_t> Sampling(double accuracy, double startDelta = 0.5) const;
   };
+
+  /**
+   * @brief Bezier curve of fixed degree class
+   * @see build_bezier_t
+   *
+   * Control points are kept in fixed-size array and curve is evaluated by Horner scheme
+   * in power basis, so neither evaluation nor sampling allocates memory
+   */
+  template <size_t degree>
+    class bezier_t {
+    private:
+      std::array<vec_t, degree + 1>
+        points,  ///< control points
+        coefs;   ///< coefficients of power basis (coefs[i] for t^i)
+
+    public:
+      /**
+       * Constructor for bezier_t
+       * @param[in] controlPoints control points
+       */
+      bezier_t(const std::array<vec_t, degree + 1> &controlPoints) noexcept : points(controlPoints) {
+        // coefs[j] = C(n, j) * sum_i (-1)^(j - i) * C(j, i) * points[i]
+        double binomN = 1;
+        for (size_t j = 0; j <= degree; j++) {
+          vec_t sum(0, 0);
+          double binomJ = 1;
+          for (size_t i = 0; i <= j; i++) {
+            sum += points[i] * ((j - i) % 2 == 0 ? binomJ : -binomJ);
+            binomJ = binomJ * (j - i) / (i + 1);
+          }
+          coefs[j] = sum * binomN;
+          binomN = binomN * (degree - j) / (j + 1);
+        }
+      }
+
+      /**
+       * Get control points function
+       * @return control points
+       */
+      const std::array<vec_t, degree + 1> & GetPoints(void) const noexcept {
+        return points;
+      }
+
+      /**
+       * Get coefficients of power basis function
+       * @return coefficients (coefs[i] for t^i)
+       */
+      const std::array<vec_t, degree + 1> & GetCoefs(void) const noexcept {
+        return coefs;
+      }
+
+      /**
+       * Check if curve is not degenerated into point function
+       * @return true if some control points are different, false - otherwise
+       */
+      bool IsCurve(void) const noexcept {
+        for (size_t i = 1; i <= degree; i++)
+          if ((points[i - 1] - points[i]).Len2() != 0)
+            return true;
+        return false;
+      }
+
+      /**
+       * Evaluate point with parameter
+       * @param[in] t parameter from 0 to 1 to evaluate point of Bezier spline
+       * @return point corresponding to parameter
+       */
+      vec_t EvaluatePoint(double t) const noexcept {
+        vec_t res = coefs[degree];
+        for (size_t i = degree; i-- > 0; )
+          res = res * t + coefs[i];
+        return res;
+      }
+
+      /**
+       * Sampling by accuracy by line segments from both ends of curve to the middle
+       * @param[in] accuracy length of elementary line segment
+       * @param[in, out] geom geometry to add points to the open primitive (first control point is added too)
+       * @param[in, out] tail scratch buffer for points sampled from the end of curve
+       * @param[in] startDelta delta to evaluate first point
+       * @warning accuracy must be greater than 0
+       */
+      void Sampling(double accuracy, geometry_t *geom, std::vector<vec_t> *tail, double startDelta = 0.5) const {
+        if (accuracy <= 0)
+          throw std::exception("Incorrect accuracy for sampling");
+
+        double delta = startDelta, accuracy2 = accuracy * accuracy;
+        double tCur[] = {0, 1}, tPrev[] = {0, 1};
+        // the last accepted points of both ends are added lazily, because the last of all is dropped
+        vec_t prevPos[] = {points[0], points[degree]};
+        tail->clear();
+
+        // first step decreasing
+        if (startDelta >= 1 && (prevPos[0] - prevPos[1]).Len2() > accuracy2)
+          delta = 0.5;
+
+        bool toFirst = 0;
+        while (tCur[0] < tCur[1]) {
+          // evaluate current param value
+          if (toFirst)
+            tCur[toFirst] = tPrev[toFirst] - delta;
+          else
+            tCur[toFirst] = tPrev[toFirst] + delta;
+          // calculate new point
+          vec_t curPos = EvaluatePoint(tCur[toFirst]);
+          // case when point is suitable : add point
+          if ((curPos - prevPos[toFirst]).Len2() <= accuracy2) {
+            if (toFirst)
+              tail->push_back(prevPos[1]);
+            else
+              geom->Add(prevPos[0]);
+            prevPos[toFirst] = curPos;
+            tPrev[toFirst] = tCur[toFirst];
+            toFirst = !toFirst;
+          }
+          // case when point is unsuitable : decrease delta
+          else {
+            delta /= 2;
+            tCur[toFirst] = tPrev[toFirst];
+          }
+        }
+
+        // the last accepted point is unordered
+        if (toFirst)
+          tail->push_back(prevPos[1]);
+        else
+          geom->Add(prevPos[0]);
+        for (auto it = tail->rbegin(); it != tail->rend(); it++)
+          geom->Add(*it);
+      }
+
+      /**
+       * Get number of uniform segments by flatness function. Wang's formula is used,
+       * so deviation of segments from curve is not greater than accuracy
+       * @param[in] accuracy maximal deviation of segments from curve
+       * @return number of segments
+       * @warning accuracy must be greater than 0
+       */
+      unsigned GetNumOfFlatSegments(double accuracy) const {
+        const double maxNumOfSegments = 1 << 16;
+        if (accuracy <= 0)
+          throw std::exception("Incorrect accuracy for sampling");
+
+        // deviation of N uniform segments is not greater than n(n - 1) / 8 * max|second difference| / N^2
+        double maxDiff2 = 0;
+        for (size_t i = 0; i + 2 <= degree; i++)
+          maxDiff2 = std::max(maxDiff2, (points[i + 2] - points[i + 1] * 2 + points[i]).Len());
+        double numOfSegments = std::ceil(std::sqrt(degree * (degree - 1) * maxDiff2 / (8 * accuracy)));
+        return (unsigned)std::min(std::max(numOfSegments, 1.0), maxNumOfSegments);
+      }
+
+      /**
+       * Sampling by flatness by uniform line segments
+       * @param[in] accuracy maximal deviation of segments from curve
+       * @param[in, out] geom geometry to add points to the open primitive (first control point is added too)
+       * @warning accuracy must be greater than 0
+       * @see GetNumOfFlatSegments
+       */
+      void SamplingByFlatness(double accuracy, geometry_t *geom) const {
+        unsigned N = GetNumOfFlatSegments(accuracy);
+
+        geom->Add(points[0]);
+        for (unsigned i = 1; i < N; i++)
+          geom->Add(EvaluatePoint((double)i / N));
+        geom->Add(points[degree]);
+      }
+    };
 }
 
 #endif /* __BEZIER_H_INCLUDED */
@@ -0,0 +1,188 @@
+/**
+ * @file
+ * @brief Bezier curves batch flattening class source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains bezier_batch_t class realisation with AVX2, SSE2 and scalar flattening kernels.
+ * AVX2 kernel is compiled for its target only and is chosen at run time by processor support
+ */
+
+#include <srm.h>
+
+#include <algorithm>
+
+/**
+ * Add curve by power basis coefficients function
+ * @param[in] curveCoefs coefficients (curveCoefs[i] for t^i)
+ * @param[in] degree curve degree (not greater than 3)
+ * @param[in] N number of uniform segments
+ * @param[in] first index of the first inner point in geometry
+ */
+void srm::bezier_batch_t::Add(const vec_t *curveCoefs, size_t degree, unsigned N, size_t first) {
+  for (size_t i = 0; i < 4; i++) {
+    coefs[0][i].push_back(i <= degree ? curveCoefs[i].x : 0);
+    coefs[1][i].push_back(i <= degree ? curveCoefs[i].y : 0);
+  }
+  numOfSegments.push_back(N);
+  firsts.push_back(first);
+}
+
+/**
+ * Evaluate inner points of curves one by one
+ * @param[in] coefs coefficients of curves by coordinate and power of t
+ * @param[in] numOfSegments number of uniform segments of curves
+ * @param[in] firsts indices of the first inner points of curves in geometry
+ * @param[in] begin index of the first curve to evaluate
+ * @param[in] end index after the last curve to evaluate
+ * @param[out] x, y coordinates of geometry points
+ */
+static void _evaluateScalar(const std::vector<double> (&coefs)[2][4], const std::vector<double> &numOfSegments,
+  const std::vector<size_t> &firsts, size_t begin, size_t end, double *x, double *y) noexcept {
+  for (size_t c = begin; c < end; c++) {
+    double n = numOfSegments[c];
+    for (unsigned j = 1; j < n; j++) {
+      double t = (double)j / n;
+      double
+        rx = coefs[0][3][c],
+        ry = coefs[1][3][c];
+      for (size_t k = 3; k-- > 0; ) {
+        rx = rx * t + coefs[0][k][c];
+        ry = ry * t + coefs[1][k][c];
+      }
+      x[firsts[c] + j - 1] = rx;
+      y[firsts[c] + j - 1] = ry;
+    }
+  }
+}
+
+#ifdef __SRM_X86
+/**
+ * Evaluate inner points of curves by pairs by SSE2 code
+ * @param[in] coefs coefficients of curves by coordinate and power of t
+ * @param[in] numOfSegments number of uniform segments of curves
+ * @param[in] firsts indices of the first inner points of curves in geometry
+ * @param[in] size number of curves
+ * @param[out] x, y coordinates of geometry points
+ * @return number of processed curves (the rest is left for scalar code)
+ */
+static size_t _evaluateSse2(const std::vector<double> (&coefs)[2][4], const std::vector<double> &numOfSegments,
+  const std::vector<size_t> &firsts, size_t size, double *x, double *y) noexcept {
+  const size_t width = 2;
+  size_t c = 0;
+  for (; c + width <= size; c += width) {
+    __m128d cx[4], cy[4];
+    for (size_t k = 0; k < 4; k++) {
+      cx[k] = _mm_loadu_pd(coefs[0][k].data() + c);
+      cy[k] = _mm_loadu_pd(coefs[1][k].data() + c);
+    }
+    __m128d n = _mm_loadu_pd(numOfSegments.data() + c);
+    double maxN = std::max(numOfSegments[c], numOfSegments[c + 1]);
+
+    for (unsigned j = 1; j < maxN; j++) {
+      __m128d t = _mm_div_pd(_mm_set1_pd((double)j), n);
+      __m128d rx = cx[3], ry = cy[3];
+      for (size_t k = 3; k-- > 0; ) {
+        rx = _mm_add_pd(_mm_mul_pd(rx, t), cx[k]);
+        ry = _mm_add_pd(_mm_mul_pd(ry, t), cy[k]);
+      }
+      alignas(16) double px[width], py[width];
+      _mm_store_pd(px, rx);
+      _mm_store_pd(py, ry);
+      // curves of group may have different number of points
+      for (size_t l = 0; l < width; l++)
+        if (j < numOfSegments[c + l]) {
+          x[firsts[c + l] + j - 1] = px[l];
+          y[firsts[c + l] + j - 1] = py[l];
+        }
+    }
+  }
+  return c;
+}
+
+/**
+ * Evaluate inner points of curves by fours by AVX2 code
+ * @param[in] coefs coefficients of curves by coordinate and power of t
+ * @param[in] numOfSegments number of uniform segments of curves
+ * @param[in] firsts indices of the first inner points of curves in geometry
+ * @param[in] size number of curves
+ * @param[out] x, y coordinates of geometry points
+ * @return number of processed curves (the rest is left for scalar code)
+ */
+__SRM_TARGET_AVX2 static size_t _evaluateAvx2(const std::vector<double> (&coefs)[2][4],
+  const std::vector<double> &numOfSegments, const std::vector<size_t> &firsts, size_t size, double *x,
+  double *y) noexcept {
+  const size_t width = 4;
+  size_t c = 0;
+  for (; c + width <= size; c += width) {
+    __m256d cx[4], cy[4];
+    for (size_t k = 0; k < 4; k++) {
+      cx[k] = _mm256_loadu_pd(coefs[0][k].data() + c);
+      cy[k] = _mm256_loadu_pd(coefs[1][k].data() + c);
+    }
+    __m256d n = _mm256_loadu_pd(numOfSegments.data() + c);
+    double maxN = numOfSegments[c];
+    for (size_t l = 1; l < width; l++)
+      maxN = std::max(maxN, numOfSegments[c + l]);
+
+    for (unsigned j = 1; j < maxN; j++) {
+      __m256d t = _mm256_div_pd(_mm256_set1_pd((double)j), n);
+      __m256d rx = cx[3], ry = cy[3];
+      for (size_t k = 3; k-- > 0; ) {
+        rx = _mm256_add_pd(_mm256_mul_pd(rx, t), cx[k]);
+        ry = _mm256_add_pd(_mm256_mul_pd(ry, t), cy[k]);
+      }
+      alignas(32) double px[width], py[width];
+      _mm256_store_pd(px, rx);
+      _mm256_store_pd(py, ry);
+      // curves of group may have different number of points
+      for (size_t l = 0; l < width; l++)
+        if (j < numOfSegments[c + l]) {
+          x[firsts[c + l] + j - 1] = px[l];
+          y[firsts[c + l] + j - 1] = py[l];
+        }
+    }
+  }
+  return c;
+}
+#endif
+
+/**
+ * Evaluate inner points of all curves and clear batch function
+ * @param[in, out] geom geometry with reserved places of points
+ * @param[in] isa instruction set (must be supported by processor)
+ */
+void srm::bezier_batch_t::Flush(geometry_t *geom, kernels::isa_t isa) noexcept {
+  size_t size = firsts.size(), done = 0;
+  double *x = geom->x.data(), *y = geom->y.data();
+
+  // Horner scheme is done by separate multiplication and addition like in bezier_t::EvaluatePoint,
+  // so results are the same as in scalar sampling for any instruction set
+#ifdef __SRM_X86
+  if (isa == kernels::isa_t::avx2)
+    done = _evaluateAvx2(coefs, numOfSegments, firsts, size, x, y);
+  else if (isa == kernels::isa_t::sse2)
+    done = _evaluateSse2(coefs, numOfSegments, firsts, size, x, y);
+#endif
+  _evaluateScalar(coefs, numOfSegments, firsts, done, size, x, y);
+  Clear();
+}
+
+/**
+ * Get number of curves in batch function
+ * @return number of curves
+ */
+size_t srm::bezier_batch_t::Size(void) const noexcept {
+  return firsts.size();
+}
+
+/**
+ * Remove all curves keeping capacity function
+ */
+void srm::bezier_batch_t::Clear(void) noexcept {
+  for (auto &coord : coefs)
+    for (auto &coef : coord)
+      coef.clear();
+  numOfSegments.clear();
+  firsts.clear();
+}
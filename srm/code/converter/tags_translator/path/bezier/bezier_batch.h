@@ -0,0 +1,85 @@
+/**
+ * @file
+ * @brief Bezier curves batch flattening class header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains bezier_batch_t class description to flatten many Bezier curves at once by SIMD kernel
+ */
+
+#pragma once
+
+#ifndef __BEZIER_BATCH_H_INCLUDED
+#define __BEZIER_BATCH_H_INCLUDED
+
+#include <vector>
+#include "bezier.h"
+#include "../../../kernels/kernels.h"
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * @brief Bezier curves batch flattening class
+   *
+   * Curves are collected in structure-of-arrays form of cubic power basis coefficients (quadratic curves have zero
+   * cubic coefficient). End points of every curve are added to geometry at once and places for inner points are
+   * reserved, so the order of points in primitives is kept. Inner points of several curves are evaluated per
+   * instruction by AVX2 or SSE2 kernel chosen at run time (scalar code is used if they are not supported).
+   */
+  class bezier_batch_t {
+  private:
+    std::vector<double>
+      coefs[2][4],     ///< coefficients of curves by coordinate (x, y) and power of t
+      numOfSegments;   ///< number of uniform segments of curves
+    std::vector<size_t> firsts;  ///< indices of the first inner points of curves in geometry
+
+    /**
+     * Add curve by power basis coefficients function
+     * @param[in] curveCoefs coefficients (curveCoefs[i] for t^i)
+     * @param[in] degree curve degree (not greater than 3)
+     * @param[in] N number of uniform segments
+     * @param[in] first index of the first inner point in geometry
+     */
+    void Add(const vec_t *curveCoefs, size_t degree, unsigned N, size_t first);
+
+  public:
+    /**
+     * Add curve to batch by flatness function. End points are added to geometry at once, inner points are
+     * evaluated by Flush
+     * @param[in] curve Bezier curve (degree 2 or 3)
+     * @param[in] accuracy maximal deviation of segments from curve
+     * @param[in, out] geom geometry to add points to the open primitive (first control point is added too)
+     * @warning accuracy must be greater than 0
+     */
+    template <size_t degree>
+      void AddByFlatness(const bezier_t<degree> &curve, double accuracy, geometry_t *geom) {
+        static_assert(degree <= 3, "Only quadratic and cubic curves are batched");
+        unsigned N = curve.GetNumOfFlatSegments(accuracy);
+
+        geom->Add(curve.GetPoints()[0]);
+        if (N > 1)
+          Add(curve.GetCoefs().data(), degree, N, geom->AddPlaceholders(N - 1));
+        geom->Add(curve.GetPoints()[degree]);
+      }
+
+    /**
+     * Evaluate inner points of all curves and clear batch function
+     * @param[in, out] geom geometry with reserved places of points
+     * @param[in] isa instruction set (must be supported by processor)
+     */
+    void Flush(geometry_t *geom, kernels::isa_t isa = kernels::GetBestIsa()) noexcept;
+
+    /**
+     * Get number of curves in batch function
+     * @return number of curves
+     */
+    size_t Size(void) const noexcept;
+
+    /**
+     * Remove all curves keeping capacity function
+     */
+    void Clear(void) noexcept;
+  };
+}
+
+#endif /* __BEZIER_BATCH_H_INCLUDED */
@@ -10,785 +10,522 @@
 #include <srm.h>
 
 #include <cctype>
-#include <sstream>
+#include <cmath>
 
 /**
  * Constructor for path_t
- * @param[in] ps pointer to a list of primitives
- * @warning pointer mustn't be nullptr
+ * @param[in, out] c conversion context
+ * @param[in] g geometry to add primitives
+ * @param[in] transform current transformation matrix (composition of all transformations of groups)
+ * @warning pointers mustn't be nullptr
  */
-srm::path_t::path_t(std::list<srm::primitive_t *> *ps, srm::transform_t transform) {
-  if(ps == nullptr)
+srm::path_t::path_t(conversion_context_t *c, geometry_t *g, srm::transform_t transform) {
+  if(c == nullptr || g == nullptr)
     throw std::exception("Incorrect pointer");
 
-  primitives = ps;
-  primitive = nullptr;
+  ctx = c;
+  geom = g;
+  cur = "";
   last = srm::vec_t(0,0);
+  subpathStart = srm::vec_t(0, 0);
   checkPoint = srm::vec_t(0, 0);
   lastCommand = '\0';
   state = srm::state_t::start;
   transformCompos = transform;
+  primFlags = 0;
+  hasPrimitives = false;
+  bounds = nullptr;
 }
 
 /**
- * Selecting a set of numbers from a string of command
- * @param[in] str string of command
- * @return Vector of numbers contained in the string
- * @warning Numbers are considered until the first invalid entry
+ * Get number of arguments in one group of command
+ * @param[in] command command letter
+ * @param[out] numOfArgs number of arguments
+ * @return true if command is known, false - otherwise
  */
-std::vector<double> srm::path_t::GetNums(const char **strPtr) noexcept {
-  const char *str = *strPtr + 1;
-  std::vector<double> nums;
+static bool _getNumOfArgs(char command, size_t *numOfArgs) noexcept {
+  switch (command) {
+    case 'Z': case 'z':
+      *numOfArgs = 0;
+      return true;
+    case 'H': case 'h': case 'V': case 'v':
+      *numOfArgs = 1;
+      return true;
+    case 'M': case 'm': case 'L': case 'l': case 'T': case 't':
+      *numOfArgs = 2;
+      return true;
+    case 'Q': case 'q': case 'S': case 's':
+      *numOfArgs = 4;
+      return true;
+    case 'C': case 'c':
+      *numOfArgs = 6;
+      return true;
+    case 'A': case 'a':
+      *numOfArgs = 7;
+      return true;
+    default:
+      return false;
+  }
+}
 
-  // process to end of line or first letter
-  while (*str != '\0' && !isalpha(static_cast<unsigned char>(*str))) {
+/**
+ * Read next number of command arguments
+ * @param[out] num read number
+ * @return reading result
+ */
+srm::path_t::token_t srm::path_t::NextNumber(double *num) noexcept {
+  while (true) {
     // skip space
-    if (isspace(static_cast<unsigned char>(*str))) {
-      str++;
-      continue;
-    }
+    while (isspace(static_cast<unsigned char>(*cur)))
+      cur++;
+    // end of line or next command
+    if (*cur == '\0' || isalpha(static_cast<unsigned char>(*cur)))
+      return token_t::end;
     // process number
-    if (isdigit(static_cast<unsigned char>(*str)) || *str == '.' || *str == '-' || *str == '+') {
-      char *end = NULL;
-      double number = strtod(str, &end);
-
-      // the sequence is not a number
-      if (str == end) {
-        state = srm::state_t::error;
-        srm::translator_t::GetPtr()->WriteLog("Warning: invalid symbol in attribute d in path");
-        break;
-      }
-
-      str = end;
+    const char *end = ParseNumber(cur, num);
+    if (end != nullptr) {
+      cur = end;
       state = srm::state_t::number;
-      nums.push_back(number);
+      return token_t::number;
     }
     // process the comma
-    else if (*str == ',') {
-      // wrong comma position
-      if (state != srm::state_t::number) {
-        state = srm::state_t::error;
-        srm::translator_t::GetPtr()->WriteLog("Warning: missing number before comma in attribute d in path");
-        break;
-      }
-
-      state = srm::state_t::comma;
-      str++;
-    }
-    // non-convertible character reached
-    else {
-      state = srm::state_t::error;
-      srm::translator_t::GetPtr()->WriteLog("Warning: invalid symbol in attribute d in path");
+    if (*cur != ',')
       break;
+    // wrong comma position
+    if (state != srm::state_t::number) {
+      state = srm::state_t::error;
+      ctx->WriteLog("Warning: missing number before comma in attribute d in path");
+      return token_t::error;
     }
+    state = srm::state_t::comma;
+    cur++;
   }
 
-  *strPtr = str;
-  return nums;
+  // non-convertible character reached
+  state = srm::state_t::error;
+  ctx->WriteLog("Warning: invalid symbol in attribute d in path");
+  return token_t::error;
 }
 
 /**
- * Processes the moveto command with absolute coordinates as arguments ("M")
- * @param[in] nums vector of numeric command arguments
+ * Add open primitive to geometry if it has segments, discard it otherwise
  */
-void srm::path_t::PathMAbs(const std::vector<double> &nums, const rapidxml::xml_node<>* tag) noexcept {
-  // add the previous primitive to the list
-  if (primitive != nullptr)
-    if (primitive->size() > 0) {
-      transform_t transform;
-      auto attr = tag->first_attribute("transform");
-      while (attr) {
-        transform *= transform_t(attr->value());
-        attr = attr->next_attribute("transform");
-      }
-      if (tag->first_attribute("transform")) {
-        transform.Apply(primitive);
-      }
-      transformCompos.Apply(primitive);
-
-      primitive->fill = IsFill(tag);
-
-      primitives->push_back(primitive);
-    }
-    else
-      delete primitive;
-
-  // create new primitive
-  primitive = new srm::primitive_t;
-
-  size_t counter = 0;
-  size_t size = nums.size();
-  // set the start of the primitive
-  if (size > 1) {
-    last = srm::vec_t(nums[counter], nums[counter + 1]);
-    counter += 2;
-    primitive->start = last;
-  }
-  else {
-    state = srm::state_t::error;
-    srm::translator_t::GetPtr()->WriteLog("Warning: wrong number of points in command M in attribute d in path");
+void srm::path_t::FinishPrimitive(void) noexcept {
+  if (bounds != nullptr)
     return;
-  }
 
-  // add a sequence of line segments to a primitive
-  for (; size - counter > 1; counter += 2) {
-    srm::vec_t cur(nums[counter], nums[counter + 1]);
-    if ((cur - last).Len2() != 0) {
-      last = cur;
-      primitive->push_back(srm::segment_t(last.x, last.y));
-    }
-  }
+  // inner points of curves are evaluated here for the whole primitive
+  if (ctx->curves.Size() != 0)
+    ctx->curves.Flush(geom);
 
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
-    state = srm::state_t::error;
-    srm::translator_t::GetPtr()->WriteLog("Warning: wrong number of points in command M in attribute d in path");
+  if (geom->GetOpenSize() <= 1) {
+    geom->Discard();
     return;
   }
+
+  // all subpaths of filled path are contours of one region
+  geom->Close(primFlags | (hasPrimitives && (primFlags & geometry_t::fill) ? geometry_t::subpath : 0));
+  hasPrimitives = true;
 }
 
 /**
- * Processes the moveto command with relative coordinates as arguments ("m")
- * @param[in] nums vector of numeric command arguments
+ * Add point transformed to the final coordinates to open primitive
+ * @param[in] p point in path coordinates
  */
-void srm::path_t::PathMRel(const std::vector<double> &nums, const rapidxml::xml_node<>* tag) noexcept {
-  // add the previous primitive to the list
-  if (primitive != nullptr)
-    if (primitive->size() > 0) {
-      transform_t transform;
-      auto attr = tag->first_attribute("transform");
-      while (attr) {
-        transform *= transform_t(attr->value());
-        attr = attr->next_attribute("transform");
-      }
-      if (tag->first_attribute("transform")) {
-        transform.Apply(primitive);
-      }
-      transformCompos.Apply(primitive);
+void srm::path_t::AddPoint(const vec_t &p) noexcept {
+  if (bounds != nullptr)
+    bounds->Add(transformCompos.TransformPoint(p));
+  else
+    geom->Add(transformCompos.TransformPoint(p));
+}
 
-      primitive->fill = IsFill(tag);
+/**
+ * Add sampled points of curve to open primitive. Affine image of Bezier curve is Bezier curve
+ * of transformed control points, so it is sampled with accuracy in the final coordinates
+ * @param[in] curve Bezier curve in path coordinates
+ */
+template <size_t degree>
+  void srm::path_t::AddBezier(const bezier_t<degree> &curve) noexcept {
+    if (!curve.IsCurve())
+      return;
+    std::array<vec_t, degree + 1> points = curve.GetPoints();
+    for (vec_t &p : points)
+      p = transformCompos.TransformPoint(p);
 
-      primitives->push_back(primitive);
+    if (bounds != nullptr) {
+      for (const vec_t &p : points)
+        bounds->Add(p);
+      return;
     }
-    else
-      delete primitive;
 
-  // create new primitive
-  primitive = new srm::primitive_t;
+    // curve lies in convex hull of control points, so curve out of sheet is replaced by chord
+    // (it is cut off by borders anyway)
+    bbox_t bbox{points[0], points[0]};
+    for (const vec_t &p : points)
+      bbox.Add(p);
+    if (bbox.IsOut(ctx->roboConf.GetW(), ctx->roboConf.GetH())) {
+      ctx->stats.culledCurves++;
+      geom->Add(points[degree]);
+      return;
+    }
 
-  size_t counter = 0;
-  size_t size = nums.size();
-  // set the start of the primitive
-  if (size > 1) {
-    last += srm::vec_t(nums[counter], nums[counter + 1]);
-    counter += 2;
-    primitive->start = last;
-  }
-  else {
-    state = srm::state_t::error;
-    srm::translator_t::GetPtr()->WriteLog("Warning: wrong number of points in command m in attribute d in path");
-    return;
-  }
+    bezier_t<degree> transformed(points);
 
-  // add a sequence of line segments to a primitive
-  for (; size - counter > 1; counter += 2) {
-    srm::vec_t delta(nums[counter], nums[counter + 1]);
-    if (delta.Len2() != 0) {
-      last += delta;
-      primitive->push_back(srm::segment_t(last.x, last.y));
-    }
+    // add a sequence of line segments to a primitive
+    if (ctx->roboConf.GetSampling() == sampling_t::flatness)
+      ctx->curves.AddByFlatness(transformed, ctx->roboConf.GetSvgAcc(), geom);
+    else
+      transformed.Sampling(ctx->roboConf.GetSvgAcc(), geom, &ctx->curveTail);
   }
 
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
-    state = srm::state_t::error;
-    srm::translator_t::GetPtr()->WriteLog("Warning: wrong number of points in command m in attribute d in path");
+/**
+ * Add sampled points of elliptical arc from the last point to open primitive
+ * @param[in] p the last arc point in path coordinates
+ * @param[in] radiuses 2 ellipse radiuses by x and y (not zero)
+ * @param[in] fA flag for arc angle size
+ * @param[in] fS flag for angle delta
+ * @param[in] phi angle
+ */
+void srm::path_t::AddArc(const vec_t &p, vec_t radiuses, bool fA, bool fS, double phi) noexcept {
+  ellipse_arc_t arc = GetEllipseArc(last, p, radiuses, fA, fS, phi, transformCompos);
+  if (bounds != nullptr) {
+    bbox_t ellipse = GetEllipseBbox(arc.center, arc.axisX, arc.axisY);
+    bounds->Add(ellipse.min);
+    bounds->Add(ellipse.max);
     return;
   }
+  // arc out of sheet is replaced by chord (it is cut off by borders anyway)
+  if (GetEllipseBbox(arc.center, arc.axisX, arc.axisY).IsOut(ctx->roboConf.GetW(), ctx->roboConf.GetH())) {
+    ctx->stats.culledCurves++;
+    geom->Add(arc.end);
+  }
+  else
+    EllipseArcSampling(arc, ctx->roboConf.GetSvgAcc(), geom);
 }
 
 /**
- * Processes the lineto command with absolute coordinates as arguments ("L")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the moveto command with absolute coordinates ("M")
+ * @param[in] args numeric arguments of group
+ * @param[in] isFirst true if this is the first group of command (moveto), false - otherwise (lineto)
  */
-void srm::path_t::PathLAbs(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-
-  // add a sequence of line segments to a primitive
-  for (; size - counter > 1; counter += 2) {
-    srm::vec_t cur(nums[counter], nums[counter + 1]);
-    if ((cur - last).Len2() != 0) {
-      last = cur;
-      primitive->push_back(srm::segment_t(last.x, last.y));
-    }
-  }
+void srm::path_t::PathMAbs(const double *args, bool isFirst) noexcept {
+  srm::vec_t p(args[0], args[1]);
 
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
-    state = srm::state_t::error;
-    srm::translator_t::GetPtr()->WriteLog("Warning: wrong number of points in command L in attribute d in path");
-    return;
+  // set the start of the primitive
+  if (isFirst) {
+    // add the previous primitive to the geometry
+    FinishPrimitive();
+    last = p;
+    subpathStart = last;
+    AddPoint(last);
+  }
+  // the following pairs are implicit lineto commands
+  else if ((p - last).Len2() != 0) {
+    last = p;
+    AddPoint(last);
   }
 }
 
 /**
- * Processes the lineto command with relative coordinates as arguments ("l")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the moveto command with relative coordinates ("m")
+ * @param[in] args numeric arguments of group
+ * @param[in] isFirst true if this is the first group of command (moveto), false - otherwise (lineto)
  */
-void srm::path_t::PathLRel(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-
-  // add a sequence of line segments to a primitive
-  for (; size - counter > 1; counter += 2) {
-    srm::vec_t delta(nums[counter], nums[counter + 1]);
-    if (delta.Len2() != 0) {
-      last += delta;
-      primitive->push_back(srm::segment_t(last.x, last.y));
-    }
-  }
+void srm::path_t::PathMRel(const double *args, bool isFirst) noexcept {
+  srm::vec_t delta(args[0], args[1]);
 
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
-    state = srm::state_t::error;
-    srm::translator_t::GetPtr()->WriteLog("Warning: wrong number of points in command l in attribute d in path");
-    return;
+  // set the start of the primitive
+  if (isFirst) {
+    // add the previous primitive to the geometry
+    FinishPrimitive();
+    last += delta;
+    subpathStart = last;
+    AddPoint(last);
+  }
+  // the following pairs are implicit lineto commands
+  else if (delta.Len2() != 0) {
+    last += delta;
+    AddPoint(last);
   }
 }
 
 /**
- * Processes the horizontal line command with absolute coordinates as arguments ("H")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the lineto command with absolute coordinates ("L")
+ * @param[in] args numeric arguments of group
  */
-void srm::path_t::PathHAbs(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-
-  // handle the wrong number of arguments
-  if(size == 0) {
-    state = srm::state_t::error;
-    srm::translator_t::GetPtr()->WriteLog("Warning: wrong number of points in command H in attribute d in path");
-    return;
-  }
-
-  // add a sequence of line segments to a primitive
-  for (; size > counter; counter++) {
-    if (nums[counter] != last.x) {
-      last.x = nums[counter];
-      primitive->push_back(srm::segment_t(last.x, last.y));
-    }
+void srm::path_t::PathLAbs(const double *args) noexcept {
+  srm::vec_t p(args[0], args[1]);
+  if ((p - last).Len2() != 0) {
+    last = p;
+    AddPoint(last);
   }
 }
 
 /**
- * Processes the horizontal line command with relative coordinates as arguments ("h")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the lineto command with relative coordinates ("l")
+ * @param[in] args numeric arguments of group
  */
-void srm::path_t::PathHRel(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-
-  // handle the wrong number of arguments
-  if (size == 0) {
-    state = srm::state_t::error;
-    srm::translator_t::GetPtr()->WriteLog("Warning: wrong number of points in command h in attribute d in path");
-    return;
-  }
-
-  // add a sequence of line segments to a primitive
-  for (; size > counter; counter++) {
-    if (nums[counter] != 0) {
-      last.x += nums[counter];
-      primitive->push_back(srm::segment_t(last.x, last.y));
-    }
+void srm::path_t::PathLRel(const double *args) noexcept {
+  srm::vec_t delta(args[0], args[1]);
+  if (delta.Len2() != 0) {
+    last += delta;
+    AddPoint(last);
   }
 }
 
 /**
- * Processes the vertical line command with absolute coordinates as arguments ("V")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the horizontal line command with absolute coordinates ("H")
+ * @param[in] args numeric arguments of group
  */
-void srm::path_t::PathVAbs(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-
-  // handle the wrong number of arguments
-  if (size == 0) {
-    state = srm::state_t::error;
-    srm::translator_t::GetPtr()->WriteLog("Warning: wrong number of points in command V in attribute d in path");
-    return;
+void srm::path_t::PathHAbs(const double *args) noexcept {
+  if (args[0] != last.x) {
+    last.x = args[0];
+    AddPoint(last);
   }
+}
 
-  // add a sequence of line segments to a primitive
-  for (; size > counter; counter++) {
-    if (nums[counter] != last.y) {
-      last.y = nums[counter];
-      primitive->push_back(srm::segment_t(last.x, last.y));
-    }
+/**
+ * Processes one group of arguments of the horizontal line command with relative coordinates ("h")
+ * @param[in] args numeric arguments of group
+ */
+void srm::path_t::PathHRel(const double *args) noexcept {
+  if (args[0] != 0) {
+    last.x += args[0];
+    AddPoint(last);
   }
 }
 
 /**
- * Processes the vertical line command with relative coordinates as arguments ("v")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the vertical line command with absolute coordinates ("V")
+ * @param[in] args numeric arguments of group
  */
-void srm::path_t::PathVRel(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-
-  // handle the wrong number of arguments
-  if (size == 0) {
-    state = srm::state_t::error;
-    srm::translator_t::GetPtr()->WriteLog("Warning: wrong number of points in command v in attribute d in path");
-    return;
+void srm::path_t::PathVAbs(const double *args) noexcept {
+  if (args[0] != last.y) {
+    last.y = args[0];
+    AddPoint(last);
   }
+}
 
-  // add a sequence of line segments to a primitive
-  for (; size > counter; counter++) {
-    if (nums[counter] != 0) {
-      last.y += nums[counter];
-      primitive->push_back(srm::segment_t(last.x, last.y));
-    }
+/**
+ * Processes one group of arguments of the vertical line command with relative coordinates ("v")
+ * @param[in] args numeric arguments of group
+ */
+void srm::path_t::PathVRel(const double *args) noexcept {
+  if (args[0] != 0) {
+    last.y += args[0];
+    AddPoint(last);
   }
 }
 
 /**
  * Processes the subpath close command ("Z" or "z")
- * @param[in] nums vector of numeric command arguments
- * @warning If the vector of arguments is not empty, then there is an error in the path record
  */
-void srm::path_t::PathZ(const std::vector<double> &nums) noexcept {
+void srm::path_t::PathZ(void) noexcept {
   // add the subpath close line segments to a primitive
-  if ((last - primitive->start).Len2() != 0) {
-    last = primitive->start;
-    primitive->push_back(srm::segment_t(last.x, last.y));
-  }
-
-  // handle the wrong number of arguments
-  if (nums.size() != 0) {
-    state = srm::state_t::error;
-    srm::translator_t::GetPtr()->WriteLog("Warning: wrong number of points in command Z/z in attribute d in path");
-    return;
+  if ((last - subpathStart).Len2() != 0) {
+    last = subpathStart;
+    AddPoint(last);
   }
 }
 
 /**
- * Processes the cubic bezier curve command with absolute coordinates as arguments ("C")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the cubic bezier curve command with absolute coordinates ("C")
+ * @param[in] args numeric arguments of group
  */
-void srm::path_t::PathCAbs(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-  srm::translator_t* trans = srm::translator_t::GetPtr();
-
-  for (; size - counter > 5; counter += 6) {
-    build_bezier_t bezier;
-    // starting point
-    bezier.push_back(last);
-    // first check point
-    checkPoint = srm::vec_t(nums[counter], nums[counter + 1]);
-    bezier.push_back(checkPoint);
-    // second check point
-    checkPoint = srm::vec_t(nums[counter + 2], nums[counter + 3]);
-    bezier.push_back(checkPoint);
-    // end point
-    last = srm::vec_t(nums[counter + 4], nums[counter + 5]);
-    bezier.push_back(last);
-    if ((bezier[0] - bezier[1]).Len2() != 0 || (bezier[1] - bezier[2]).Len2() != 0 || (bezier[2] - bezier[3]).Len2() != 0) {
-      std::vector<vec_t> res;
-      res = bezier.Sampling(trans->roboConf.GetSvgAcc());
-      // add a sequence of line segments to a primitive
-      for (auto& r : res)
-        primitive->push_back(srm::segment_t(r.x, r.y));
-    }
-  }
-
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
-    state = srm::state_t::error;
-    trans->WriteLog("Warning: wrong number of points in command C in attribute d in path");
-    return;
-  }
+void srm::path_t::PathCAbs(const double *args) noexcept {
+  // starting point
+  srm::vec_t start = last;
+  // first check point
+  srm::vec_t check = srm::vec_t(args[0], args[1]);
+  // second check point
+  checkPoint = srm::vec_t(args[2], args[3]);
+  // end point
+  last = srm::vec_t(args[4], args[5]);
+  AddBezier(bezier_t<3>({start, check, checkPoint, last}));
 }
 
 /**
- * Processes the cubic bezier curve command with relative coordinates as arguments ("c")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the cubic bezier curve command with relative coordinates ("c")
+ * @param[in] args numeric arguments of group
  */
-void srm::path_t::PathCRel(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-  srm::translator_t* trans = srm::translator_t::GetPtr();
-
-  for (; size - counter > 5; counter += 6) {
-    build_bezier_t bezier;
-    // starting point
-    bezier.push_back(last);
-    // first check point
-    checkPoint = last + srm::vec_t(nums[counter], nums[counter + 1]);
-    bezier.push_back(checkPoint);
-    // second check point
-    checkPoint = last + srm::vec_t(nums[counter + 2], nums[counter + 3]);
-    bezier.push_back(checkPoint);
-    // end point
-    last += srm::vec_t(nums[counter + 4], nums[counter + 5]);
-    bezier.push_back(last);
-    if ((bezier[0] - bezier[1]).Len2() != 0 || (bezier[1] - bezier[2]).Len2() != 0 || (bezier[2] - bezier[3]).Len2() != 0) {
-      std::vector<vec_t> res;
-      res = bezier.Sampling(trans->roboConf.GetSvgAcc());
-      // add a sequence of line segments to a primitive
-      for (auto& r : res)
-        primitive->push_back(srm::segment_t(r.x, r.y));
-    }
-  }
-
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
-    state = srm::state_t::error;
-    trans->WriteLog("Warning: wrong number of points in command c in attribute d in path");
-    return;
-  }
+void srm::path_t::PathCRel(const double *args) noexcept {
+  // starting point
+  srm::vec_t start = last;
+  // first check point
+  srm::vec_t check = last + srm::vec_t(args[0], args[1]);
+  // second check point
+  checkPoint = last + srm::vec_t(args[2], args[3]);
+  // end point
+  last += srm::vec_t(args[4], args[5]);
+  AddBezier(bezier_t<3>({start, check, checkPoint, last}));
 }
 
 /**
- * Processes the quadratic bezier curve command with absolute coordinates as arguments ("Q")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the quadratic bezier curve command with absolute coordinates ("Q")
+ * @param[in] args numeric arguments of group
  */
-void srm::path_t::PathQAbs(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-  srm::translator_t* trans = srm::translator_t::GetPtr();
-
-  for (; size - counter > 3; counter += 4) {
-    build_bezier_t bezier;
-    // starting point
-    bezier.push_back(last);
-    // check point
-    checkPoint = srm::vec_t(nums[counter], nums[counter + 1]);
-    bezier.push_back(checkPoint);
-    // end point
-    last = srm::vec_t(nums[counter + 2], nums[counter + 3]);
-    bezier.push_back(last);
-    if ((bezier[0] - bezier[1]).Len2() != 0 || (bezier[1] - bezier[2]).Len2() != 0) {
-      std::vector<vec_t> res;
-      res = bezier.Sampling(trans->roboConf.GetSvgAcc());
-      // add a sequence of line segments to a primitive
-      for (auto& r : res)
-        primitive->push_back(srm::segment_t(r.x, r.y));
-    }
-  }
-  
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
-    state = srm::state_t::error;
-    trans->WriteLog("Warning: wrong number of points in command Q in attribute d in path");
-    return;
-  }
+void srm::path_t::PathQAbs(const double *args) noexcept {
+  // starting point
+  srm::vec_t start = last;
+  // check point
+  checkPoint = srm::vec_t(args[0], args[1]);
+  // end point
+  last = srm::vec_t(args[2], args[3]);
+  AddBezier(bezier_t<2>({start, checkPoint, last}));
 }
 
 /**
- * Processes the quadratic bezier curve command with relative coordinates as arguments ("q")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the quadratic bezier curve command with relative coordinates ("q")
+ * @param[in] args numeric arguments of group
  */
-void srm::path_t::PathQRel(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-  srm::translator_t* trans = srm::translator_t::GetPtr();
-
-  for (; size - counter > 3; counter += 4) {
-    build_bezier_t bezier;
-    // starting point
-    bezier.push_back(last);
-    // check point
-    checkPoint = last + srm::vec_t(nums[counter], nums[counter + 1]);
-    bezier.push_back(checkPoint);
-    // end point
-    last += srm::vec_t(nums[counter + 2], nums[counter + 3]);
-    bezier.push_back(last);
-    if ((bezier[0] - bezier[1]).Len2() != 0 || (bezier[1] - bezier[2]).Len2() != 0) {
-      std::vector<vec_t> res;
-      res = bezier.Sampling(trans->roboConf.GetSvgAcc());
-      // add a sequence of line segments to a primitive
-      for (auto& r : res)
-        primitive->push_back(srm::segment_t(r.x, r.y));
-    }
-  }
-
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
-    state = srm::state_t::error;
-    trans->WriteLog("Warning: wrong number of points in command q in attribute d in path");
-    return;
-  }
+void srm::path_t::PathQRel(const double *args) noexcept {
+  // starting point
+  srm::vec_t start = last;
+  // check point
+  checkPoint = last + srm::vec_t(args[0], args[1]);
+  // end point
+  last += srm::vec_t(args[2], args[3]);
+  AddBezier(bezier_t<2>({start, checkPoint, last}));
 }
 
 /**
- * Processes the smooth cubic bezier curve command with absolute coordinates as arguments ("S")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the smooth cubic bezier curve command with absolute coordinates ("S")
+ * @param[in] args numeric arguments of group
  */
-void srm::path_t::PathSAbs(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-  srm::translator_t* trans = srm::translator_t::GetPtr();
-
-  for (; size - counter > 3; counter += 4) {
-    build_bezier_t bezier;
-    // starting point
-    bezier.push_back(last);
-    // first check point
-    if (lastCommand == 's' || lastCommand == 'S' || lastCommand == 'c' || lastCommand == 'C')
-      checkPoint = last * 2 - checkPoint;
-    else {
-      checkPoint = last;
-      lastCommand = 'S';
-    }
-    bezier.push_back(checkPoint);
-    // second check point
-    checkPoint = srm::vec_t(nums[counter], nums[counter + 1]);
-    bezier.push_back(checkPoint);
-    // end point
-    last = srm::vec_t(nums[counter + 2], nums[counter + 3]);
-    bezier.push_back(last);
-    if ((bezier[0] - bezier[1]).Len2() != 0 || (bezier[1] - bezier[2]).Len2() != 0 || (bezier[2] - bezier[3]).Len2() != 0) {
-      std::vector<vec_t> res;
-      res = bezier.Sampling(trans->roboConf.GetSvgAcc());
-      // add a sequence of line segments to a primitive
-      for (auto& r : res)
-        primitive->push_back(srm::segment_t(r.x, r.y));
-    }
-  }
+void srm::path_t::PathSAbs(const double *args) noexcept {
+  // starting point
+  srm::vec_t start = last;
+  // first check point
+  srm::vec_t check;
+  if (lastCommand == 's' || lastCommand == 'S' || lastCommand == 'c' || lastCommand == 'C')
+    check = last * 2 - checkPoint;
+  else
+    check = last;
+  // second check point
+  checkPoint = srm::vec_t(args[0], args[1]);
+  // end point
+  last = srm::vec_t(args[2], args[3]);
+  AddBezier(bezier_t<3>({start, check, checkPoint, last}));
+}
 
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
-    state = srm::state_t::error;
-    trans->WriteLog("Warning: wrong number of points in command S in attribute d in path");
-    return;
-  }
+/**
+ * Processes one group of arguments of the smooth cubic bezier curve command with relative coordinates ("s")
+ * @param[in] args numeric arguments of group
+ */
+void srm::path_t::PathSRel(const double *args) noexcept {
+  // starting point
+  srm::vec_t start = last;
+  // first check point
+  srm::vec_t check;
+  if (lastCommand == 's' || lastCommand == 'S' || lastCommand == 'c' || lastCommand == 'C')
+    check = last * 2 - checkPoint;
+  else
+    check = last;
+  // second check point
+  checkPoint = last + srm::vec_t(args[0], args[1]);
+  // end point
+  last += srm::vec_t(args[2], args[3]);
+  AddBezier(bezier_t<3>({start, check, checkPoint, last}));
 }
 
 /**
- * Processes the smooth cubic bezier curve command with relative coordinates as arguments ("s")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the smooth quadratic bezier curve command with absolute coordinates ("T")
+ * @param[in] args numeric arguments of group
  */
-void srm::path_t::PathSRel(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-  srm::translator_t* trans = srm::translator_t::GetPtr();
-
-  for (; size - counter > 3; counter += 4) {
-    build_bezier_t bezier;
-    // starting point
-    bezier.push_back(last);
-    // first check point
-    if (lastCommand == 's' || lastCommand == 'S' || lastCommand == 'c' || lastCommand == 'C')
-      checkPoint = last * 2 - checkPoint;
-    else {
-      checkPoint = last;
-      lastCommand = 's';
-    }
-    bezier.push_back(checkPoint);
-    // second check point
-    checkPoint = last + srm::vec_t(nums[counter], nums[counter + 1]);
-    bezier.push_back(checkPoint);
-    // end point
-    last += srm::vec_t(nums[counter + 2], nums[counter + 3]);
-    bezier.push_back(last);
-    if ((bezier[0] - bezier[1]).Len2() != 0 || (bezier[1] - bezier[2]).Len2() != 0 || (bezier[2] - bezier[3]).Len2() != 0) {
-      std::vector<vec_t> res;
-      res = bezier.Sampling(trans->roboConf.GetSvgAcc());
-      // add a sequence of line segments to a primitive
-      for (auto& r : res)
-        primitive->push_back(srm::segment_t(r.x, r.y));
-    }
-  }
+void srm::path_t::PathTAbs(const double *args) noexcept {
+  // starting point
+  srm::vec_t start = last;
+  // check point
+  if (lastCommand == 't' || lastCommand == 'T' || lastCommand == 'q' || lastCommand == 'Q')
+    checkPoint = last * 2 - checkPoint;
+  else
+    checkPoint = last;
+  // end point
+  last = srm::vec_t(args[0], args[1]);
+  AddBezier(bezier_t<2>({start, checkPoint, last}));
+}
 
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
-    state = srm::state_t::error;
-    trans->WriteLog("Warning: wrong number of points in command s in attribute d in path");
-    return;
-  }
+/**
+ * Processes one group of arguments of the smooth quadratic bezier curve command with relative coordinates ("t")
+ * @param[in] args numeric arguments of group
+ */
+void srm::path_t::PathTRel(const double *args) noexcept {
+  // starting point
+  srm::vec_t start = last;
+  // check point
+  if (lastCommand == 't' || lastCommand == 'T' || lastCommand == 'q' || lastCommand == 'Q')
+    checkPoint = last * 2 - checkPoint;
+  else
+    checkPoint = last;
+  // end point
+  last += srm::vec_t(args[0], args[1]);
+  AddBezier(bezier_t<2>({start, checkPoint, last}));
 }
 
 /**
- * Processes the smooth quadratic bezier curve command with absolute coordinates as arguments ("T")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the elliptical arc command with absolute coordinates ("A")
+ * @param[in] args numeric arguments of group
  */
-void srm::path_t::PathTAbs(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-  srm::translator_t* trans = srm::translator_t::GetPtr();
-
-  for (; size - counter > 1; counter += 2) {
-    build_bezier_t bezier;
-    // starting point
-    bezier.push_back(last);
-    // check point
-    if (lastCommand == 't' || lastCommand == 'T' || lastCommand == 'q' || lastCommand == 'Q')
-      checkPoint = last * 2 - checkPoint;
-    else {
-      checkPoint = last;
-      lastCommand = 'T';
-    }
-    bezier.push_back(checkPoint);
-    // end point
-    last = srm::vec_t(nums[counter], nums[counter + 1]);
-    bezier.push_back(last);
-    if ((bezier[0] - bezier[1]).Len2() != 0 || (bezier[1] - bezier[2]).Len2() != 0) {
-      std::vector<vec_t> res;
-      res = bezier.Sampling(trans->roboConf.GetSvgAcc());
-      // add a sequence of line segments to a primitive
-      for (auto& r : res)
-        primitive->push_back(srm::segment_t(r.x, r.y));
-    }
+void srm::path_t::PathAAbs(const double *args) noexcept {
+  double phi = args[2] / 180 * pi, fA = args[3], fS = args[4];
+  // check flags
+  if (fA != 0 && fA != 1) {
+    state = srm::state_t::error;
+    ctx->WriteLog("Warning: invalid flag fA in command A in attribute d in path");
+    return;
   }
- 
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
+  if (fS != 0 && fS != 1) {
     state = srm::state_t::error;
-    trans->WriteLog("Warning: wrong number of points in command T in attribute d in path");
+    ctx->WriteLog("Warning: invalid flag fS in command A in attribute d in path");
     return;
   }
-}
 
-/**
- * Processes the smooth quadratic bezier curve command with relative coordinates as arguments ("t")
- * @param[in] nums vector of numeric command arguments
- */
-void srm::path_t::PathTRel(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-  srm::translator_t* trans = srm::translator_t::GetPtr();
-
-  for (; size - counter > 1; counter += 2) {
-    build_bezier_t bezier;
-    // starting point
-    bezier.push_back(last);
-    // check point
-    if (lastCommand == 't' || lastCommand == 'T' || lastCommand == 'q' || lastCommand == 'Q')
-      checkPoint = last * 2 - checkPoint;
-    else {
-      checkPoint = last;
-      lastCommand = 't';
+  srm::vec_t radiuses(fabs(args[0]), fabs(args[1])), p(args[5], args[6]);
+  if ((p - last).Len2() != 0) {
+    // check radiuses
+    if (radiuses.x == 0 || radiuses.y == 0) {
+      last = p;
+      AddPoint(last);
     }
-    bezier.push_back(checkPoint);
-    // end point
-    last += srm::vec_t(nums[counter], nums[counter + 1]);
-    bezier.push_back(last);
-    if ((bezier[0] - bezier[1]).Len2() != 0 || (bezier[1] - bezier[2]).Len2() != 0) {
-      std::vector<vec_t> res;
-      res = bezier.Sampling(trans->roboConf.GetSvgAcc());
+    else {
       // add a sequence of line segments to a primitive
-      for (auto& r : res)
-        primitive->push_back(srm::segment_t(r.x, r.y));
+      AddArc(p, radiuses, fA, fS, phi);
+      last = p;
     }
   }
-
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
-    state = srm::state_t::error;
-    trans->WriteLog("Warning: wrong number of points in command t in attribute d in path");
-    return;
-  }
 }
 
 /**
- * Processes the elliptical arc command with absolute coordinates as arguments ("A")
- * @param[in] nums vector of numeric command arguments
+ * Processes one group of arguments of the elliptical arc command with relative coordinates ("a")
+ * @param[in] args numeric arguments of group
  */
-void srm::path_t::PathAAbs(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-  srm::translator_t* trans = srm::translator_t::GetPtr();
-
-  for (; size - counter > 6; counter += 7) {
-    double phi = nums[counter + 2] / 180 * pi, fA = nums[counter + 3], fS = nums[counter + 4];
-    // check flags
-    if (fA != 0 && fA != 1) {
-      state = srm::state_t::error;
-      trans->WriteLog("Warning: invalid flag fA in command A in attribute d in path");
-      return;
-    }
-    if (fS != 0 && fS != 1) {
-      state = srm::state_t::error;
-      trans->WriteLog("Warning: invalid flag fS in command A in attribute d in path");
-      return;
-    }
-
-    srm::vec_t radiuses(fabs(nums[counter]), fabs(nums[counter + 1])), cur(nums[counter + 5], nums[counter + 6]);
-    if ((cur - last).Len2() != 0) {
-      // check radiuses
-      if (radiuses.x == 0 || radiuses.y == 0) {
-        last = cur;
-        primitive->push_back(srm::segment_t(last.x, last.y));
-      }
-      else {
-        std::vector<vec_t> res;
-        res = EllipseArcSampling(last, cur, radiuses, fA, fS, phi, trans->roboConf.GetSvgAcc());
-        last = cur;
-        // add a sequence of line segments to a primitive
-        for (auto& r : res)
-          primitive->push_back(srm::segment_t(r.x, r.y));
-      }
-    }
+void srm::path_t::PathARel(const double *args) noexcept {
+  double phi = args[2] / 180 * pi, fA = args[3], fS = args[4];
+  // check flags
+  if (fA != 0 && fA != 1) {
+    state = srm::state_t::error;
+    ctx->WriteLog("Warning: invalid flag fA in command a in attribute d in path");
+    return;
   }
-
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
+  if (fS != 0 && fS != 1) {
     state = srm::state_t::error;
-    trans->WriteLog("Warning: wrong number of parameters in command A in attribute d in path");
+    ctx->WriteLog("Warning: invalid flag fS in command a in attribute d in path");
     return;
   }
-}
 
-/**
- * Processes the elliptical arc command with relative coordinates as arguments ("a")
- * @param[in] nums vector of numeric command arguments
- */
-void srm::path_t::PathARel(const std::vector<double> &nums) noexcept {
-  size_t counter = 0;
-  size_t size = nums.size();
-  srm::translator_t* trans = srm::translator_t::GetPtr();
-
-  for (; size - counter > 6; counter += 7) {
-    double phi = nums[counter + 2] / 180 * pi, fA = nums[counter + 3], fS = nums[counter + 4];
-    // check flags
-    if (fA != 0 && fA != 1) {
-      state = srm::state_t::error;
-      trans->WriteLog("Warning: invalid flag fA in command a in attribute d in path");
-      return;
-    }
-    if (fS != 0 && fS != 1) {
-      state = srm::state_t::error;
-      trans->WriteLog("Warning: invalid flag fS in command a in attribute d in path");
-      return;
+  srm::vec_t radiuses(fabs(args[0]), fabs(args[1])), delta(args[5], args[6]);
+  if (delta.Len2() != 0) {
+    // check radiuses
+    if (radiuses.x == 0 || radiuses.y == 0) {
+      last += delta;
+      AddPoint(last);
     }
-
-    srm::vec_t radiuses(fabs(nums[counter]), fabs(nums[counter + 1])), delta(nums[counter + 5], nums[counter + 6]);
-    if (delta.Len2() != 0) {
-      // check radiuses
-      if (radiuses.x == 0 || radiuses.y == 0) {
-        last += delta;
-        primitive->push_back(srm::segment_t(last.x, last.y));
-      }
-      else {
-        std::vector<vec_t> res;
-        res = EllipseArcSampling(last, last + delta, radiuses, fA, fS, phi, trans->roboConf.GetSvgAcc());
-        last += delta;
-        // add a sequence of line segments to a primitive
-        for (auto& r : res)
-          primitive->push_back(srm::segment_t(r.x, r.y));
-      }
+    else {
+      // add a sequence of line segments to a primitive
+      AddArc(last + delta, radiuses, fA, fS, phi);
+      last += delta;
     }
   }
-
-  // handle the wrong number of arguments
-  if (size - counter > 0) {
-    state = srm::state_t::error;
-    trans->WriteLog("Warning: wrong number of parameters in command a in attribute d in path");
-    return;
-  }
 }
 
 /**
@@ -796,126 +533,143 @@ void srm::path_t::PathARel(const std::vector<double> &nums) noexcept {
  * @param[in] tag pointer to path node in xml DOM
  */
 void srm::path_t::ParsePath(const rapidxml::xml_node<> *tag) noexcept {
-  const char *attr = tag->first_attribute("d")->value();
-  char command;
-
-  while (*attr != '\0') {
+  // tag attributes are the same for all primitives of path, so tag transformation is parsed once
+  // and fused with the current transformation matrix
+  if (tag->first_attribute("transform") != nullptr)
+    transformCompos *= transform_t(ctx, tag);
+  primFlags = GetFillFlags(ctx->roboConf, tag);
+
+  cur = tag->first_attribute("d")->value();
+  while (state != srm::state_t::error) {
     // skip space
-    if (isspace(static_cast<unsigned char>(*attr))) {
-      attr++;
-      continue;
+    while (isspace(static_cast<unsigned char>(*cur)))
+      cur++;
+    if (*cur == '\0')
+      break;
+    // unhandled character
+    if (!isalpha(static_cast<unsigned char>(*cur))) {
+      state = srm::state_t::error;
+      ctx->WriteLog("Warning: invalid symbol in attribute d in path");
+      break;
     }
-    // command handling
-    if (isalpha(static_cast<unsigned char>(*attr))) {
-      command = *attr;
-      if (state == srm::state_t::start) {
-        // wrong start of path string
-        if (command != 'm' && command != 'M') {
-          state = srm::state_t::error;
-          srm::translator_t::GetPtr()->WriteLog("Warning: wrong first command in attribute d in path");
-          break;
-        }
-      }
-
-      std::vector<double> nums;
-      nums = this->GetNums(&attr);
-      switch (command) {
-        case 'M':
-          this->PathMAbs(nums, tag);
-          break;
-        case 'm':
-          this->PathMRel(nums, tag);
-          break;
-        case 'L':
-          this->PathLAbs(nums);
-          break;
-        case 'l':
-          this->PathLRel(nums);
-          break;
-        case 'H':
-          this->PathHAbs(nums);
-          break;
-        case 'h':
-          this->PathHRel(nums);
-          break;
-        case 'V':
-          this->PathVAbs(nums);
-          break;
-        case 'v':
-          this->PathVRel(nums);
-          break;
-        case 'Z':
-        case 'z':
-          this->PathZ(nums);
-          break;
-        case 'C':
-          this->PathCAbs(nums);
-          break;
-        case 'c':
-          this->PathCRel(nums);
-          break;
-        case 'Q':
-          this->PathQAbs(nums);
-          break;
-        case 'q':
-          this->PathQRel(nums);
-          break;
-        case 'S':
-          this->PathSAbs(nums);
-          break;
-        case 's':
-          this->PathSRel(nums);
-          break;
-        case 'T':
-          this->PathTAbs(nums);
-          break;
-        case 't':
-          this->PathTRel(nums);
-          break;
-        case 'A':
-          this->PathAAbs(nums);
-          break;
-        case 'a':
-          this->PathARel(nums);
-          break;
-        default:
-          state = srm::state_t::error;
-          srm::translator_t::GetPtr()->WriteLog("Warning: invalid symbol in attribute d in path");
-          break;
-      }
-
-      // discard the part after the first error
-      if (state == srm::state_t::error)
-        break;
 
-      state = srm::state_t::command;
-      lastCommand = command;
+    // command handling
+    char command = *cur++;
+    size_t numOfArgs;
+    if (state == srm::state_t::start && command != 'm' && command != 'M') {
+      // wrong start of path string
+      state = srm::state_t::error;
+      ctx->WriteLog("Warning: wrong first command in attribute d in path");
+      break;
     }
-    // unhandled character
-    else {
+    if (!_getNumOfArgs(command, &numOfArgs)) {
       state = srm::state_t::error;
-      srm::translator_t::GetPtr()->WriteLog("Warning: invalid symbol in attribute d in path");
+      ctx->WriteLog("Warning: invalid symbol in attribute d in path");
       break;
     }
-  }
-  // add the last primitive
-  if (primitive != nullptr)
-    if (primitive->size() > 0) {
-      transform_t transform;
-      auto attr = tag->first_attribute("transform");
-      while (attr) {
-        transform *= transform_t(attr->value());
-        attr = attr->next_attribute("transform");
+    state = srm::state_t::command;
+
+    double args[7];
+    if (numOfArgs == 0) {
+      this->PathZ();
+      // handle the wrong number of arguments
+      if (NextNumber(args) == token_t::number) {
+        state = srm::state_t::error;
+        ctx->WriteLog("Warning: wrong number of points in command Z/z in attribute d in path");
       }
-      if (tag->first_attribute("transform")) {
-        transform.Apply(primitive);
+    }
+    else {
+      // every complete group of arguments is processed at once
+      size_t numOfGroups = 0, numOfRead = 0;
+      while (state != srm::state_t::error && NextNumber(args + numOfRead) == token_t::number) {
+        if (++numOfRead < numOfArgs)
+          continue;
+
+        switch (command) {
+          case 'M':
+            this->PathMAbs(args, numOfGroups == 0);
+            break;
+          case 'm':
+            this->PathMRel(args, numOfGroups == 0);
+            break;
+          case 'L':
+            this->PathLAbs(args);
+            break;
+          case 'l':
+            this->PathLRel(args);
+            break;
+          case 'H':
+            this->PathHAbs(args);
+            break;
+          case 'h':
+            this->PathHRel(args);
+            break;
+          case 'V':
+            this->PathVAbs(args);
+            break;
+          case 'v':
+            this->PathVRel(args);
+            break;
+          case 'C':
+            this->PathCAbs(args);
+            break;
+          case 'c':
+            this->PathCRel(args);
+            break;
+          case 'Q':
+            this->PathQAbs(args);
+            break;
+          case 'q':
+            this->PathQRel(args);
+            break;
+          case 'S':
+            this->PathSAbs(args);
+            break;
+          case 's':
+            this->PathSRel(args);
+            break;
+          case 'T':
+            this->PathTAbs(args);
+            break;
+          case 't':
+            this->PathTRel(args);
+            break;
+          case 'A':
+            this->PathAAbs(args);
+            break;
+          case 'a':
+            this->PathARel(args);
+            break;
+        }
+        lastCommand = command;
+        numOfGroups++;
+        numOfRead = 0;
       }
-      transformCompos.Apply(primitive);
 
-      primitive->fill = IsFill(tag);
-
-      primitives->push_back(primitive);
+      // handle the wrong number of arguments
+      if (state != srm::state_t::error && (numOfRead != 0 ||
+        (numOfGroups == 0 && (numOfArgs == 1 || command == 'M' || command == 'm')))) {
+        state = srm::state_t::error;
+        ctx->WriteLog(std::string("Warning: wrong number of ") + (numOfArgs == 7 ? "parameters" : "points") +
+          " in command " + command + " in attribute d in path");
+      }
     }
-    else
-      delete primitive;
-}
\ No newline at end of file
+    lastCommand = command;
+  }
+  // add the last primitive
+  FinishPrimitive();
+}
+
+/**
+ * Get bounding box of path in the final coordinates without sampling function.
+ * Box contains control points of curves and whole ellipses of arcs, so it may be larger than path
+ * @param[in] tag pointer to path node in xml DOM
+ * @return bounding box (min is more than max if path has no points)
+ */
+srm::bbox_t srm::path_t::GetBbox(const rapidxml::xml_node<> *tag) noexcept {
+  bbox_t bbox{vec_t(HUGE_VAL, HUGE_VAL), vec_t(-HUGE_VAL, -HUGE_VAL)};
+  bounds = &bbox;
+  ParsePath(tag);
+  bounds = nullptr;
+  return bbox;
+}
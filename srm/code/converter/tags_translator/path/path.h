@@ -14,9 +14,7 @@
 
 #include <srm.h>
 
-#include <list>
-#include <string>
-#include <vector>
+#include <cstdint>
 
 /** \brief Project namespace */
 namespace srm {
@@ -32,166 +30,221 @@ namespace srm {
     command,
     error
   };
+
   /**
    * @brief Path parsing class
    *
-   * Contains method to parse path
+   * Streaming tokenizer of path data: numbers are parsed in place from the attribute buffer
+   * and each complete group of command arguments is converted to geometry at once
    */
   class path_t {
   private:
-    std::list<srm::primitive_t *> *primitives;  ///< pointer to the currently filling list of primitives
-    srm::primitive_t *primitive;                ///< pointer to the currently filling primitive
+    /**
+     * @brief Number token reading result
+     */
+    enum class token_t {
+      number,  ///< number is read
+      end,     ///< arguments of command are ended (command letter or end of data)
+      error    ///< invalid data
+    };
+
+    conversion_context_t *ctx;                  ///< conversion context
+    geometry_t *geom;                           ///< geometry to add primitives (the currently filling primitive is open in it)
+    const char *cur;                            ///< current position in path data
     srm::vec_t last;                            ///< last significant point
+    srm::vec_t subpathStart;                    ///< the first point of the current subpath
     srm::vec_t checkPoint;                      ///< last control point of the last Bezier curve
     char lastCommand;                           ///< previous command
     state_t state;                              ///< the current state of the analyzer
-    srm::transform_t transformCompos;           ///< composition of all transformations
+    srm::transform_t transformCompos;           ///< composition of all transformations with transformation of path tag
+    uint8_t primFlags;                          ///< flags of path primitives
+    bool hasPrimitives;                         ///< true if path already has added primitives
+    bbox_t *bounds;                             ///< bounding box to extend by points instead of adding them to geometry
+                                                ///< (nullptr - path is converted to primitives)
+
+    /**
+     * Read next number of command arguments
+     * @param[out] num read number
+     * @return reading result
+     */
+    token_t NextNumber(double *num) noexcept;
+
+    /**
+     * Add open primitive to geometry if it has segments, discard it otherwise
+     */
+    void FinishPrimitive(void) noexcept;
 
     /**
-     * Selecting a set of numbers from a string of command
-     * @param[in] str string of command
-     * @return Vector of numbers contained in the string
-     * @warning Numbers are considered until the first invalid entry 
+     * Add point transformed to the final coordinates to open primitive
+     * @param[in] p point in path coordinates
      */
-    std::vector<double> GetNums(const char **str) noexcept;
+    void AddPoint(const vec_t &p) noexcept;
+
+    /**
+     * Add sampled points of curve to open primitive. Affine image of Bezier curve is Bezier curve
+     * of transformed control points, so it is sampled with accuracy in the final coordinates
+     * @param[in] curve Bezier curve in path coordinates
+     */
+    template <size_t degree>
+      void AddBezier(const bezier_t<degree> &curve) noexcept;
+
+    /**
+     * Add sampled points of elliptical arc from the last point to open primitive
+     * @param[in] p the last arc point in path coordinates
+     * @param[in] radiuses 2 ellipse radiuses by x and y (not zero)
+     * @param[in] fA flag for arc angle size
+     * @param[in] fS flag for angle delta
+     * @param[in] phi angle
+     */
+    void AddArc(const vec_t &p, vec_t radiuses, bool fA, bool fS, double phi) noexcept;
 
     /**
      * @defgroup pathCommandParse Path command parse functions
-     * @brief Functions to parse commands from path
+     * @brief Functions to process commands from path
      *
      * @{
      */
 
     /**
-     * Processes the moveto command with absolute coordinates as arguments ("M")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the moveto command with absolute coordinates ("M")
+     * @param[in] args numeric arguments of group
+     * @param[in] isFirst true if this is the first group of command (moveto), false - otherwise (lineto)
      */
-    void PathMAbs(const std::vector<double> &nums, const rapidxml::xml_node<>* tag) noexcept;
+    void PathMAbs(const double *args, bool isFirst) noexcept;
 
     /**
-     * Processes the moveto command with relative coordinates as arguments ("m")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the moveto command with relative coordinates ("m")
+     * @param[in] args numeric arguments of group
+     * @param[in] isFirst true if this is the first group of command (moveto), false - otherwise (lineto)
      */
-    void PathMRel(const std::vector<double> &nums, const rapidxml::xml_node<>* tag) noexcept;
+    void PathMRel(const double *args, bool isFirst) noexcept;
 
     /**
-     * Processes the lineto command with absolute coordinates as arguments ("L")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the lineto command with absolute coordinates ("L")
+     * @param[in] args numeric arguments of group
      */
-    void PathLAbs(const std::vector<double> &nums) noexcept;
+    void PathLAbs(const double *args) noexcept;
 
     /**
-     * Processes the lineto command with relative coordinates as arguments ("l")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the lineto command with relative coordinates ("l")
+     * @param[in] args numeric arguments of group
      */
-    void PathLRel(const std::vector<double> &nums) noexcept;
+    void PathLRel(const double *args) noexcept;
 
     /**
-     * Processes the horizontal line command with absolute coordinates as arguments ("H")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the horizontal line command with absolute coordinates ("H")
+     * @param[in] args numeric arguments of group
      */
-    void PathHAbs(const std::vector<double> &nums) noexcept;
+    void PathHAbs(const double *args) noexcept;
 
     /**
-     * Processes the horizontal line command with relative coordinates as arguments ("h")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the horizontal line command with relative coordinates ("h")
+     * @param[in] args numeric arguments of group
      */
-    void PathHRel(const std::vector<double> &nums) noexcept;
+    void PathHRel(const double *args) noexcept;
 
     /**
-     * Processes the vertical line command with absolute coordinates as arguments ("V")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the vertical line command with absolute coordinates ("V")
+     * @param[in] args numeric arguments of group
      */
-    void PathVAbs(const std::vector<double> &nums) noexcept;
+    void PathVAbs(const double *args) noexcept;
 
     /**
-     * Processes the vertical line command with relative coordinates as arguments ("v")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the vertical line command with relative coordinates ("v")
+     * @param[in] args numeric arguments of group
      */
-    void PathVRel(const std::vector<double> &nums) noexcept;
+    void PathVRel(const double *args) noexcept;
 
     /**
      * Processes the subpath close command ("Z" or "z")
-     * @param[in] nums vector of numeric command arguments
-     * @warning If the vector of arguments is not empty, then there is an error in the path record
      */
-    void PathZ(const std::vector<double> &nums) noexcept;
+    void PathZ(void) noexcept;
 
     /**
-     * Processes the cubic bezier curve command with absolute coordinates as arguments ("C")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the cubic bezier curve command with absolute coordinates ("C")
+     * @param[in] args numeric arguments of group
      */
-    void PathCAbs(const std::vector<double> &nums) noexcept;
+    void PathCAbs(const double *args) noexcept;
 
     /**
-     * Processes the cubic bezier curve command with relative coordinates as arguments ("c")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the cubic bezier curve command with relative coordinates ("c")
+     * @param[in] args numeric arguments of group
      */
-    void PathCRel(const std::vector<double> &nums) noexcept;
+    void PathCRel(const double *args) noexcept;
 
     /**
-     * Processes the quadratic bezier curve command with absolute coordinates as arguments ("Q")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the quadratic bezier curve command with absolute coordinates ("Q")
+     * @param[in] args numeric arguments of group
      */
-    void PathQAbs(const std::vector<double> &nums) noexcept;
+    void PathQAbs(const double *args) noexcept;
 
     /**
-     * Processes the quadratic bezier curve command with relative coordinates as arguments ("q")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the quadratic bezier curve command with relative coordinates ("q")
+     * @param[in] args numeric arguments of group
      */
-    void PathQRel(const std::vector<double> &nums) noexcept;
+    void PathQRel(const double *args) noexcept;
 
     /**
-     * Processes the smooth cubic bezier curve command with absolute coordinates as arguments ("S")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the smooth cubic bezier curve command with absolute coordinates ("S")
+     * @param[in] args numeric arguments of group
      */
-    void PathSAbs(const std::vector<double> &nums) noexcept;
+    void PathSAbs(const double *args) noexcept;
 
     /**
-     * Processes the smooth cubic bezier curve command with relative coordinates as arguments ("s")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the smooth cubic bezier curve command with relative coordinates ("s")
+     * @param[in] args numeric arguments of group
      */
-    void PathSRel(const std::vector<double> &nums) noexcept;
+    void PathSRel(const double *args) noexcept;
 
     /**
-     * Processes the smooth quadratic bezier curve command with absolute coordinates as arguments ("T")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the smooth quadratic bezier curve command with absolute coordinates ("T")
+     * @param[in] args numeric arguments of group
      */
-    void PathTAbs(const std::vector<double> &nums) noexcept;
+    void PathTAbs(const double *args) noexcept;
 
     /**
-     * Processes the smooth quadratic bezier curve command with relative coordinates as arguments ("t")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the smooth quadratic bezier curve command with relative coordinates ("t")
+     * @param[in] args numeric arguments of group
      */
-    void PathTRel(const std::vector<double> &nums) noexcept;
+    void PathTRel(const double *args) noexcept;
 
     /**
-     * Processes the elliptical arc command with absolute coordinates as arguments ("A")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the elliptical arc command with absolute coordinates ("A")
+     * @param[in] args numeric arguments of group
      */
-    void PathAAbs(const std::vector<double> &nums) noexcept;
+    void PathAAbs(const double *args) noexcept;
 
     /**
-     * Processes the elliptical arc command with relative coordinates as arguments ("a")
-     * @param[in] nums vector of numeric command arguments
+     * Processes one group of arguments of the elliptical arc command with relative coordinates ("a")
+     * @param[in] args numeric arguments of group
      */
-    void PathARel(const std::vector<double> &nums) noexcept;
+    void PathARel(const double *args) noexcept;
 
     /**@}*/
 
   public:
     /**
      * Constructor for path_t
-     * @param[in] ps pointer to a list of primitives
-     * @warning pointer mustn't be nullptr
+     * @param[in, out] c conversion context
+     * @param[in] g geometry to add primitives
+     * @param[in] transform current transformation matrix (composition of all transformations of groups)
+     * @warning pointers mustn't be nullptr
      */
-    path_t(std::list<srm::primitive_t *> *ps, srm::transform_t transform);
+    path_t(conversion_context_t *c, geometry_t *g, srm::transform_t transform);
 
     /**
      * Main path parsing function
      * @param[in] tag pointer to path node in xml DOM
      */
     void ParsePath(const rapidxml::xml_node<> *tag) noexcept;
+
+    /**
+     * Get bounding box of path in the final coordinates without sampling function.
+     * Box contains control points of curves and whole ellipses of arcs, so it may be larger than path
+     * @param[in] tag pointer to path node in xml DOM
+     * @return bounding box (min is more than max if path has no points)
+     */
+    bbox_t GetBbox(const rapidxml::xml_node<> *tag) noexcept;
   };
 }
 
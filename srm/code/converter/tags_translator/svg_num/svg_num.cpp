@@ -0,0 +1,183 @@
+/**
+ * @file
+ * @brief Svg numbers and lengths parsing functions source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains realisation of locale-free parsing functions of svg numbers and lengths
+ */
+
+#include <srm.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Check if symbol is decimal digit (locale-free)
+ * @param[in] sym symbol
+ * @return true if symbol is digit, false - otherwise
+ */
+static bool _isDigit(char sym) noexcept {
+  return sym >= '0' && sym <= '9';
+}
+
+/**
+ * Check if symbol is svg white space
+ * @param[in] sym symbol
+ * @return true if symbol is space, false - otherwise
+ */
+static bool _isSpace(char sym) noexcept {
+  return sym == ' ' || sym == '\t' || sym == '\n' || sym == '\r' || sym == '\f' || sym == '\v';
+}
+
+/**
+ * Parse svg number function
+ * @param[in] str position of number (leading spaces are not skipped)
+ * @param[out] num parsed number
+ * @return position after number, nullptr if there is no number (num is not changed)
+ */
+const char * srm::ParseNumber(const char *str, double *num) noexcept {
+  // powers of 10 which are exactly represented in double
+  static const double pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  const uint64_t maxExactMantissa = (uint64_t)1 << 53;
+  const uint64_t maxMantissa = (UINT64_MAX - 9) / 10;
+  const char *start = str;
+  bool isNegative = false, isExact = true, hasDigits = false;
+  uint64_t mantissa = 0;
+  int exponent = 0;
+
+  if (*str == '-' || *str == '+')
+    isNegative = *str++ == '-';
+
+  // integer part
+  for (; _isDigit(*str); str++) {
+    hasDigits = true;
+    if (mantissa <= maxMantissa)
+      mantissa = mantissa * 10 + (*str - '0');
+    else {
+      isExact = false;
+      exponent++;
+    }
+  }
+  // fraction part
+  if (*str == '.') {
+    for (str++; _isDigit(*str); str++) {
+      hasDigits = true;
+      if (mantissa <= maxMantissa) {
+        mantissa = mantissa * 10 + (*str - '0');
+        exponent--;
+      }
+      else
+        isExact = false;
+    }
+  }
+  if (!hasDigits)
+    return nullptr;
+
+  // exponent part is taken only if it is complete ("1em" is number 1 and unit em)
+  if (*str == 'e' || *str == 'E') {
+    const char *exp = str + 1;
+    bool isExpNegative = false;
+    int expValue = 0;
+
+    if (*exp == '-' || *exp == '+')
+      isExpNegative = *exp++ == '-';
+    if (_isDigit(*exp)) {
+      for (; _isDigit(*exp); exp++)
+        if (expValue < 100000)
+          expValue = expValue * 10 + (*exp - '0');
+      exponent += isExpNegative ? -expValue : expValue;
+      str = exp;
+    }
+  }
+
+  // exact mantissa and power of 10 give correctly rounded result in one operation
+  if (isExact && mantissa <= maxExactMantissa && exponent >= -22 && exponent <= 22) {
+    double value = (double)mantissa;
+    value = exponent < 0 ? value / pow10[-exponent] : value * pow10[exponent];
+    *num = isNegative ? -value : value;
+  }
+  // rare long numbers are correctly rounded by locale-free std::from_chars, token is already checked
+  // to be decimal number of svg grammar (std::from_chars does not accept plus sign)
+  else {
+    double value = 0;
+    auto res = std::from_chars(*start == '+' ? start + 1 : start, str, value);
+    if (res.ec == std::errc::result_out_of_range)
+      value = exponent > 0 ? HUGE_VAL : 0;
+    if (res.ec == std::errc::result_out_of_range && isNegative)
+      value = -value;
+    *num = value;
+  }
+  return str;
+}
+
+/**
+ * Skip spaces function
+ * @param[in] str zero terminated string
+ * @return position of first not space symbol
+ */
+const char * srm::SkipSpaces(const char *str) noexcept {
+  while (_isSpace(*str))
+    str++;
+  return str;
+}
+
+/**
+ * Skip separator of svg list (spaces with one optional comma) function
+ * @param[in] str zero terminated string
+ * @return position after separator
+ */
+const char * srm::SkipSeparator(const char *str) noexcept {
+  str = SkipSpaces(str);
+  if (*str == ',')
+    str = SkipSpaces(str + 1);
+  return str;
+}
+
+/**
+ * Parse svg length attribute (number with optional unit px, mm, cm, in, pt or %) function
+ * @param[in] str zero terminated attribute value
+ * @param[in] percentBase length corresponding to 100%
+ * @param[out] length length in user units
+ * @return true if whole value is a length, false - otherwise (length is not changed)
+ */
+bool srm::ParseLength(const char *str, double percentBase, double *length) noexcept {
+  /**
+   * @brief Length unit struct
+   */
+  struct unit_t {
+    const char *name;  ///< unit name
+    double scale;      ///< number of user units (css pixels) in one unit
+  };
+  static const unit_t units[] = {
+    {"px", 1}, {"mm", 96 / 25.4}, {"cm", 96 / 2.54}, {"in", 96}, {"pt", 96 / 72.0}
+  };
+  double value;
+
+  str = ParseNumber(SkipSpaces(str), &value);
+  if (str == nullptr)
+    return false;
+
+  if (*str == '%') {
+    value = percentBase * value / 100;
+    str++;
+  }
+  else
+    for (const auto &unit : units)
+      if (strncmp(str, unit.name, 2) == 0) {
+        if (unit.scale != 1)
+          value *= unit.scale;
+        str += 2;
+        break;
+      }
+
+  if (*SkipSpaces(str) != '\0')
+    return false;
+  *length = value;
+  return true;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file
+ * @brief Svg numbers and lengths parsing functions header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains locale-free parsing functions of svg numbers and lengths which work in place without exceptions
+ */
+
+#pragma once
+
+#ifndef __SVG_NUM_H_INCLUDED
+#define __SVG_NUM_H_INCLUDED
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * Parse svg number function
+   * @param[in] str position of number (leading spaces are not skipped)
+   * @param[out] num parsed number
+   * @return position after number, nullptr if there is no number (num is not changed)
+   */
+  const char * ParseNumber(const char *str, double *num) noexcept;
+
+  /**
+   * Skip spaces function
+   * @param[in] str zero terminated string
+   * @return position of first not space symbol
+   */
+  const char * SkipSpaces(const char *str) noexcept;
+
+  /**
+   * Skip separator of svg list (spaces with one optional comma) function
+   * @param[in] str zero terminated string
+   * @return position after separator
+   */
+  const char * SkipSeparator(const char *str) noexcept;
+
+  /**
+   * Parse svg length attribute (number with optional unit px, mm, cm, in, pt or %) function
+   * @param[in] str zero terminated attribute value
+   * @param[in] percentBase length corresponding to 100%
+   * @param[out] length length in user units
+   * @return true if whole value is a length, false - otherwise (length is not changed)
+   */
+  bool ParseLength(const char *str, double percentBase, double *length) noexcept;
+}
+
+#endif /* __SVG_NUM_H_INCLUDED */
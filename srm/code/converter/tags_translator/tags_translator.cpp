@@ -10,158 +10,159 @@
 #include <srm.h>
 
 #include <cmath>
-#include <sstream>
+#include <cstring>
 
 /**
- * Transform svg polyline to primitive
- * @param[in] tag pointer to polyline node in xml DOM
- * @param[out] polylinePrimitive the primitive representations of polyline
+ * Add points of polyline or polygon to primitive
+ * @param[in, out] ctx conversion context
+ * @param[in] tag pointer to polyline or polygon node in xml DOM
+ * @param[in] tagName name of tag for logs
+ * @param[in, out] geom geometry to add points to the open primitive
+ * @return true if start point is added, false - otherwise
  */
-static void _polylineToPrimitive(const rapidxml::xml_node<> *tag, srm::primitive_t *polylinePrimitive) noexcept {
-  srm::translator_t *trans = srm::translator_t::GetPtr();
-  
+static bool _pointsToPrimitive(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *tag, const char *tagName,
+  srm::geometry_t *geom) noexcept {
   if (!tag->last_attribute("points")) {
-    trans->WriteLog("Warning: attribute points in polyline is not set");
-    return;
+    ctx->WriteLog(std::string("Warning: attribute points in ") + tagName + " is not set");
+    return false;
   }
 
-  std::string points(tag->last_attribute("points")->value());
-  for (auto &sym : points) {
-    if (!isdigit(sym) && sym != ',' && sym != ' ') {
-      trans->WriteLog("Warning: invalid symbol in attribute points in polyline");
-      return;
+  // points are added up to the first error
+  const char *str = srm::SkipSpaces(tag->last_attribute("points")->value());
+  size_t numOfPoints = 0;
+  while (*str != '\0') {
+    double x, y;
+    const char *next = srm::ParseNumber(str, &x);
+    if (next == nullptr) {
+      ctx->WriteLog(std::string("Warning: invalid symbol in attribute points in ") + tagName);
+      return numOfPoints != 0;
     }
-    if (sym == ',') {
-      sym = ' ';
+    next = srm::SkipSeparator(next);
+    if (*next == '\0') {
+      ctx->WriteLog(std::string("Warning: wrong number of points in attribute points in ") + tagName);
+      return numOfPoints != 0;
     }
-  }
-  std::istringstream iss(points);
-  double x, y;
-  iss >> x >> y;
-  if (iss.fail()) {
-    trans->WriteLog("Warning: wrong start point in attribute points in polyline");
-    return;
-  }
-  polylinePrimitive->start.x = x;
-  polylinePrimitive->start.y = y;
-  while (!iss.eof()) {
-    iss >> x >> y;
-    if (!iss.fail()) {
-      polylinePrimitive->push_back(srm::segment_t(x, y));
-    }
-    else {
-      std::string check;
-      iss >> check;
-      if (check != "") {
-        trans->WriteLog("Warning: wrong number of points in attribute points in polyline");
-        return;
-      }
+    next = srm::ParseNumber(next, &y);
+    if (next == nullptr) {
+      ctx->WriteLog(std::string("Warning: invalid symbol in attribute points in ") + tagName);
+      return numOfPoints != 0;
     }
+    geom->Add(x, y);
+    numOfPoints++;
+    str = srm::SkipSeparator(next);
+  }
+
+  if (numOfPoints == 0) {
+    ctx->WriteLog(std::string("Warning: wrong start point in attribute points in ") + tagName);
+    return false;
   }
+  return true;
+}
+
+/**
+ * Transform svg polyline to primitive
+ * @param[in, out] ctx conversion context
+ * @param[in] tag pointer to polyline node in xml DOM
+ * @param[in, out] geom geometry to add the primitive representation of polyline
+ */
+static void _polylineToPrimitive(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *tag, srm::geometry_t *geom) noexcept {
+  _pointsToPrimitive(ctx, tag, "polyline", geom);
 }
 
 /**
  * Transform svg polygon to primitive
+ * @param[in, out] ctx conversion context
  * @param[in] tag pointer to polygon node in xml DOM
- * @param[out] polygonPrimitive the primitive representations of polygon
+ * @param[in, out] geom geometry to add the primitive representation of polygon
  */
-static void _polygonToPrimitive(const rapidxml::xml_node<> *tag, srm::primitive_t *polygonPrimitive) noexcept {
-  srm::translator_t* trans = srm::translator_t::GetPtr();
+static void _polygonToPrimitive(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *tag, srm::geometry_t *geom) noexcept {
+  if (_pointsToPrimitive(ctx, tag, "polygon", geom))
+    geom->Add(geom->GetPoint(geom->GetOpenBegin()));
+}
 
-  if (!tag->last_attribute("points")) {
-    trans->WriteLog("Warning: attribute points in polygon is not set");
-    return;
-  }
+/**
+ * Skip element out of sheet function
+ * @param[in, out] ctx conversion context
+ * @param[in] bbox bounding box of element in the final coordinates
+ * @return true if element is out of sheet and must be skipped, false - otherwise
+ */
+static bool _cullElement(srm::conversion_context_t *ctx, const srm::bbox_t &bbox) noexcept {
+  if (!bbox.IsOut(ctx->roboConf.GetW(), ctx->roboConf.GetH()))
+    return false;
+  ctx->stats.culledElements++;
+  return true;
+}
 
-  std::string points(tag->last_attribute("points")->value());
-  for (auto& sym : points) {
-    if (!isdigit(sym) && sym != ',' && sym != ' ') {
-      trans->WriteLog("Warning: invalid symbol in attribute points in polygon");
-      return;
-    }
-    if (sym == ',') {
-      sym = ' ';
-    }
-  }
-  std::istringstream iss(points);
-  double x, y;
-  iss >> x >> y;
-  if (iss.fail()) {
-    trans->WriteLog("Warning: wrong start point in attribute points in polygon");
-    return;
-  }
-  polygonPrimitive->start.x = x;
-  polygonPrimitive->start.y = y;
-  while (!iss.eof()) {
-    iss >> x >> y;
-    if (!iss.fail()) {
-      polygonPrimitive->push_back(srm::segment_t(x, y));
-    }
-    else {
-      std::string check;
-      iss >> check;
-      if (check != "") {
-        trans->WriteLog("Warning: wrong number of points in attribute points in polygon");
-        return;
-      }
-    }
-  }
-  polygonPrimitive->push_back(srm::segment_t(polygonPrimitive->start.x, polygonPrimitive->start.y));
+/**
+ * Get bounding box of points in the final coordinates function
+ * @param[in] transform transformation of points to the final coordinates
+ * @param[in] points points
+ * @param[in] numOfPoints number of points (not zero)
+ * @return bounding box
+ */
+static srm::bbox_t _getBbox(const srm::transform_t &transform, const srm::vec_t *points, size_t numOfPoints) noexcept {
+  srm::vec_t p = transform.TransformPoint(points[0]);
+  srm::bbox_t bbox{p, p};
+  for (size_t i = 1; i < numOfPoints; i++)
+    bbox.Add(transform.TransformPoint(points[i]));
+  return bbox;
+}
+
+/**
+ * Skip open primitive out of sheet function. Used for elements with points known only after parsing
+ * @param[in, out] ctx conversion context
+ * @param[in] geom geometry with the open primitive in the final coordinates
+ * @return true if primitive is out of sheet and must be discarded, false - otherwise
+ */
+static bool _cullOpenPrimitive(srm::conversion_context_t *ctx, const srm::geometry_t &geom) noexcept {
+  size_t first = geom.GetOpenBegin(), last = first + geom.GetOpenSize();
+  srm::bbox_t bbox{geom.GetPoint(first), geom.GetPoint(first)};
+  for (size_t i = first + 1; i < last; i++)
+    bbox.Add(geom.GetPoint(i));
+  if (!_cullElement(ctx, bbox))
+    return false;
+  ctx->stats.culledPoints += last - first;
+  return true;
 }
 
- /**
-  * Transform svg ellipse to primitive
-  * @param[in] tag pointer to ellipse node in xml DOM
-  * @param[out] ellipsePrimitive the primitive representations of ellipse
-  */
-static void _ellipseToPrimitive(const rapidxml::xml_node<> *tag, srm::primitive_t *ellipsePrimitive) noexcept {
+/**
+ * Get parameters of svg ellipse
+ * @param[in, out] ctx conversion context
+ * @param[in] tag pointer to ellipse node in xml DOM
+ * @param[out] center center of ellipse
+ * @param[out] radiuses radiuses of ellipse by x and y
+ * @return true if ellipse is valid, false - otherwise
+ */
+static bool _getEllipse(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *tag,
+  srm::vec_t *center, srm::vec_t *radiuses) noexcept {
   double cx, cy, rx, ry;
   const double defaultCoord = 0;
-  srm::translator_t *trans = srm::translator_t::GetPtr();
 
   if (tag->last_attribute("cx")) {
-    try {
-      cx = std::stod(tag->last_attribute("cx")->value(), NULL);
-      if (std::string(tag->last_attribute("cx")->value()).find("%") != std::string::npos) {
-        cx = trans->roboConf.GetW() * cx / 100;
-      }
-    }
-    catch (std::exception) {
+    if (!srm::ParseLength(tag->last_attribute("cx")->value(), ctx->roboConf.GetW(), &cx)) {
       cx = defaultCoord;
-      trans->WriteLog("Warning: invalid attribute cx in ellipse");
+      ctx->WriteLog("Warning: invalid attribute cx in ellipse");
     }
   }
   else {
     cx = defaultCoord;
-    trans->WriteLog("Warning: attribute cx is not set in ellipse");
+    ctx->WriteLog("Warning: attribute cx is not set in ellipse");
   }
 
   if (tag->last_attribute("cy")) {
-    try {
-      cy = std::stod(tag->last_attribute("cy")->value(), NULL);
-      if (std::string(tag->last_attribute("cy")->value()).find("%") != std::string::npos) {
-        cy = trans->roboConf.GetH() * cy / 100;
-      }
-    }
-    catch (std::exception) {
+    if (!srm::ParseLength(tag->last_attribute("cy")->value(), ctx->roboConf.GetH(), &cy)) {
       cy = defaultCoord;
-      trans->WriteLog("Warning: invalid attribute cy in ellipse");
+      ctx->WriteLog("Warning: invalid attribute cy in ellipse");
     }
   }
   else {
     cy = defaultCoord;
-    trans->WriteLog("Warning: attribute cy is not set in ellipse");
+    ctx->WriteLog("Warning: attribute cy is not set in ellipse");
   }
 
   if (tag->last_attribute("rx")) {
-    try {
-      rx = std::stod(tag->last_attribute("rx")->value(), NULL);
-      if (std::string(tag->last_attribute("rx")->value()).find("%") != std::string::npos) {
-        rx = trans->roboConf.GetW() * rx / 100;
-      }
-    }
-    catch (std::exception) {
-      ry = -1;
+    if (!srm::ParseLength(tag->last_attribute("rx")->value(), ctx->roboConf.GetW(), &rx)) {
+      rx = -1;
     }
   }
   else {
@@ -169,13 +170,7 @@ static void _ellipseToPrimitive(const rapidxml::xml_node<> *tag, srm::primitive_
   }
   
   if (tag->last_attribute("ry")) {
-    try {
-      ry = std::stod(tag->last_attribute("ry")->value(), NULL);
-      if (std::string(tag->last_attribute("ry")->value()).find("%") != std::string::npos) {
-        ry = trans->roboConf.GetH() * ry / 100;
-      }
-    }
-    catch (std::exception) {
+    if (!srm::ParseLength(tag->last_attribute("ry")->value(), ctx->roboConf.GetH(), &ry)) {
       ry = -1;
     }
   }
@@ -183,474 +178,649 @@ static void _ellipseToPrimitive(const rapidxml::xml_node<> *tag, srm::primitive_
     ry = -1;
   }
 
+  // missed radius is equal to the other one
   if (rx > 0 && ry <= 0) {
-    trans->WriteLog("Warning: invalid attribute ry in ellipse");
+    ctx->WriteLog("Warning: invalid attribute ry in ellipse");
+    ry = rx;
   }
   else if (rx <= 0 && ry > 0) {
-    trans->WriteLog("Warning: invalid attribute rx in ellipse");
+    ctx->WriteLog("Warning: invalid attribute rx in ellipse");
+    rx = ry;
   }
   else if (rx <= 0 && ry <= 0) {
-    trans->WriteLog("Warning: invalid attributes rx and ry in ellipse");
-    return;
+    ctx->WriteLog("Warning: invalid attributes rx and ry in ellipse");
+    return false;
   }
- 
-  std::vector<srm::vec_t> discreteEllipse =
-    srm::EllipseSampling(srm::vec_t(cx, cy), srm::vec_t(rx, ry), trans->roboConf.GetSvgAcc());
-  
-  ellipsePrimitive->start.x = discreteEllipse[0].x;
-  ellipsePrimitive->start.y = discreteEllipse[0].y;
-  ellipsePrimitive->reserve(discreteEllipse.size() - 1);
-  for (unsigned int i = 1; i < discreteEllipse.size(); ++i) {
-    ellipsePrimitive->push_back(srm::segment_t(discreteEllipse[i].x, discreteEllipse[i].y));
+
+  *center = srm::vec_t(cx, cy);
+  *radiuses = srm::vec_t(rx, ry);
+  return true;
+}
+
+/**
+ * Remove primitives of element out of sheet function. Used for paths whose points are known only after parsing
+ * @param[in, out] ctx conversion context
+ * @param[in, out] geom geometry with primitives of element at the end
+ * @param[in] first index of the first primitive of element
+ */
+static void _cullPrimitives(srm::conversion_context_t *ctx, srm::geometry_t *geom, size_t first) noexcept {
+  if (first == geom->Size())
+    return;
+
+  srm::bbox_t bbox = geom->bboxes[first];
+  for (size_t i = first + 1; i < geom->Size(); i++) {
+    bbox.Add(geom->bboxes[i].min);
+    bbox.Add(geom->bboxes[i].max);
   }
+  if (!_cullElement(ctx, bbox))
+    return;
+  ctx->stats.culledPoints += geom->x.size() - geom->Begin(first);
+  geom->Truncate(first);
 }
 
 /**
- * Transform svg line to primitive
+ * Transform svg ellipse to primitive
+ * @param[in, out] ctx conversion context
+ * @param[in] tag pointer to ellipse node in xml DOM
+ * @param[in] transform transformation of ellipse to the final coordinates (ellipse is sampled after it)
+ * @param[in, out] geom geometry to add the transformed primitive representation of ellipse
+ */
+static void _ellipseToPrimitive(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *tag,
+  const srm::transform_t &transform, srm::geometry_t *geom) noexcept {
+  srm::vec_t c, r;
+  if (!_getEllipse(ctx, tag, &c, &r))
+    return;
+
+  srm::vec_t
+    center = transform.TransformPoint(c),
+    axisX = transform.TransformVector(srm::vec_t(r.x, 0)),
+    axisY = transform.TransformVector(srm::vec_t(0, r.y));
+  if (_cullElement(ctx, srm::GetEllipseBbox(center, axisX, axisY)))
+    return;
+
+  ctx->stats.shapes++;
+  if (ctx->shapeCache.AddEllipse(center, axisX, axisY, ctx->roboConf.GetSvgAcc(), geom))
+    ctx->stats.shapeHits++;
+}
+
+/**
+ * Get end points of svg line
+ * @param[in, out] ctx conversion context
  * @param[in] tag pointer to line node in xml DOM
- * @param[out] linePrimitive the primitive representations of line
+ * @param[out] points 2 end points of line
+ * @return true if line is not degenerate, false - otherwise
  */
-static void _lineToPrimitive(const rapidxml::xml_node<> *tag, srm::primitive_t *linePrimitive) noexcept {
+static bool _getLine(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *tag, srm::vec_t *points) noexcept {
   double x1, y1, x2, y2;
   const double defaultCoord = 0;
-  srm::translator_t *trans = srm::translator_t::GetPtr();
  
   if (tag->last_attribute("x1")) {
-    try {
-      x1 = std::stod(tag->last_attribute("x1")->value(), NULL);
-      if (std::string(tag->last_attribute("x1")->value()).find("%") != std::string::npos) {
-        x1 = trans->roboConf.GetW() * x1 / 100;
-      }
-    }
-    catch (std::exception) {
+    if (!srm::ParseLength(tag->last_attribute("x1")->value(), ctx->roboConf.GetW(), &x1)) {
       x1 = defaultCoord;
-      trans->WriteLog("Warning: invalid attribute x1 in line");
+      ctx->WriteLog("Warning: invalid attribute x1 in line");
     }
   }
   else {
     x1 = defaultCoord;
-    trans->WriteLog("Warning: attribute x1 in line is not set");
+    ctx->WriteLog("Warning: attribute x1 in line is not set");
   }
 
   if (tag->last_attribute("x2")) {
-    try {
-      x2 = std::stod(tag->last_attribute("x2")->value(), NULL);
-      if (std::string(tag->last_attribute("x2")->value()).find("%") != std::string::npos) {
-        x2 = trans->roboConf.GetW() * x2 / 100;
-      }
-    }
-    catch (std::exception) {
+    if (!srm::ParseLength(tag->last_attribute("x2")->value(), ctx->roboConf.GetW(), &x2)) {
       x2 = defaultCoord;
-      trans->WriteLog("Warning: invalid attribute x2 in line");
+      ctx->WriteLog("Warning: invalid attribute x2 in line");
     }
   }
   else {
     x2 = defaultCoord;
-    trans->WriteLog("Warning: attribute x2 in line is not set");
+    ctx->WriteLog("Warning: attribute x2 in line is not set");
   }
 
   if (tag->last_attribute("y1")) {
-    try {
-      y1 = std::stod(tag->last_attribute("y1")->value(), NULL);
-      if (std::string(tag->last_attribute("y1")->value()).find("%") != std::string::npos) {
-        y1 = trans->roboConf.GetH() * y1 / 100;
-      }
-    }
-    catch (std::exception) {
+    if (!srm::ParseLength(tag->last_attribute("y1")->value(), ctx->roboConf.GetH(), &y1)) {
       y1 = defaultCoord;
-      trans->WriteLog("Warning: invalid attribute y1 in line");
+      ctx->WriteLog("Warning: invalid attribute y1 in line");
     }
   }
   else {
     y1 = defaultCoord;
-    trans->WriteLog("Warning: attribute y1 in line is not set");
+    ctx->WriteLog("Warning: attribute y1 in line is not set");
   }
 
   if (tag->last_attribute("y2")) {
-    try {
-      y2 = std::stod(tag->last_attribute("y2")->value(), NULL);
-      if (std::string(tag->last_attribute("y2")->value()).find("%") != std::string::npos) {
-        y2 = trans->roboConf.GetH() * y2 / 100;
-      }
-    }
-    catch (std::exception) {
+    if (!srm::ParseLength(tag->last_attribute("y2")->value(), ctx->roboConf.GetH(), &y2)) {
       y2 = defaultCoord;
-      trans->WriteLog("Warning: invalid attribute y2 in line");
+      ctx->WriteLog("Warning: invalid attribute y2 in line");
     }
   }
   else {
     y2 = defaultCoord;
-    trans->WriteLog("Warning: attribute y2 in line is not set");
+    ctx->WriteLog("Warning: attribute y2 in line is not set");
   }
 
   if (x1 == x2 && y1 == y2)
+    return false;
+
+  points[0] = srm::vec_t(x1, y1);
+  points[1] = srm::vec_t(x2, y2);
+  return true;
+}
+
+/**
+ * Transform svg line to primitive
+ * @param[in, out] ctx conversion context
+ * @param[in] tag pointer to line node in xml DOM
+ * @param[in] transform transformation of line to the final coordinates
+ * @param[in, out] geom geometry to add the primitive representation of line
+ */
+static void _lineToPrimitive(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *tag,
+  const srm::transform_t &transform, srm::geometry_t *geom) noexcept {
+  srm::vec_t points[2];
+  if (!_getLine(ctx, tag, points) || _cullElement(ctx, _getBbox(transform, points, 2)))
     return;
 
-  srm::segment_t p(x2, y2);
-  linePrimitive->start.x = x1;
-  linePrimitive->start.y = y1;
-  linePrimitive->push_back(p);
+  geom->Add(points[0]);
+  geom->Add(points[1]);
 }
 
 /**
- * Transform svg circle to primitive
+ * Get parameters of svg circle
+ * @param[in, out] ctx conversion context
  * @param[in] tag pointer to circle node in xml DOM
- * @param[out] circlePrimitive the primitive representations of circle
+ * @param[out] center center of circle
+ * @param[out] radius radius of circle
+ * @return true if circle is valid, false - otherwise
  */
-static void _circleToPrimitive(const rapidxml::xml_node<> *tag, srm::primitive_t *circlePrimitive) noexcept{
+static bool _getCircle(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *tag,
+  srm::vec_t *center, double *radius) noexcept {
   double cx, cy, r;
   const double defaultCoord = 0;
-  srm::translator_t *trans = srm::translator_t::GetPtr();
 
   if (tag->last_attribute("cx")) {
-    try {
-      cx = std::stod(tag->last_attribute("cx")->value(), NULL);
-      if (std::string(tag->last_attribute("cx")->value()).find("%") != std::string::npos) {
-        cx = trans->roboConf.GetW() * cx / 100;
-      }
-    }
-    catch (std::exception) {
+    if (!srm::ParseLength(tag->last_attribute("cx")->value(), ctx->roboConf.GetW(), &cx)) {
       cx = defaultCoord;
-      trans->WriteLog("Warning: invalid attribute cx in circle");
+      ctx->WriteLog("Warning: invalid attribute cx in circle");
     }
   }
   else {
     cx = defaultCoord;
-    trans->WriteLog("Warning: attribute cx is not set in circle");
+    ctx->WriteLog("Warning: attribute cx is not set in circle");
   }
 
   if (tag->last_attribute("cy")) {
-    try {
-      cy = std::stod(tag->last_attribute("cy")->value(), NULL);
-      if (std::string(tag->last_attribute("cy")->value()).find("%") != std::string::npos) {
-        cy = trans->roboConf.GetH() * cy / 100;
-      }
-    }
-    catch (std::exception) {
+    if (!srm::ParseLength(tag->last_attribute("cy")->value(), ctx->roboConf.GetH(), &cy)) {
       cy = defaultCoord;
-      trans->WriteLog("Warning: invalid attribute cy in circle");
+      ctx->WriteLog("Warning: invalid attribute cy in circle");
     }
   }
   else {
     cy = defaultCoord;
-    trans->WriteLog("Warning: attribute cy is not set in circle");
+    ctx->WriteLog("Warning: attribute cy is not set in circle");
   }
 
   if (tag->last_attribute("r")) {
-    try {
-      r = std::stod(tag->last_attribute("r")->value(), NULL);
-      if (r <= 0) {
-        trans->WriteLog("Warning: attribute r in circle must be more than 0");
-        return;
-      }
-      if (std::string(tag->last_attribute("r")->value()).find("%") != std::string::npos) {
-        r = trans->roboConf.GetW() * r / 100;
-      }
+    if (!srm::ParseLength(tag->last_attribute("r")->value(), ctx->roboConf.GetW(), &r)) {
+      ctx->WriteLog("Warning: invalid attribute r in circle");
+      return false;
     }
-    catch (std::exception) {
-      trans->WriteLog("Warning: invalid attribute r in circle");
-      return;
+    if (r <= 0) {
+      ctx->WriteLog("Warning: attribute r in circle must be more than 0");
+      return false;
     }
   }
   else {
-    trans->WriteLog("Warning: attribute r is not set in circle");
-    return;
+    ctx->WriteLog("Warning: attribute r is not set in circle");
+    return false;
   }
 
-  std::vector<srm::vec_t> discreteCircle =
-    srm::EllipseSampling(srm::vec_t(cx, cy), srm::vec_t(r, r), trans->roboConf.GetSvgAcc());
+  *center = srm::vec_t(cx, cy);
+  *radius = r;
+  return true;
+}
 
-  circlePrimitive->start.x = discreteCircle[0].x;
-  circlePrimitive->start.y = discreteCircle[0].y;
-  circlePrimitive->reserve(discreteCircle.size() - 1);
-  for (unsigned int i = 1; i < discreteCircle.size(); ++i) {
-    circlePrimitive->push_back(srm::segment_t(discreteCircle[i].x, discreteCircle[i].y));
-  }
+/**
+ * Transform svg circle to primitive
+ * @param[in, out] ctx conversion context
+ * @param[in] tag pointer to circle node in xml DOM
+ * @param[in] transform transformation of circle to the final coordinates (circle is sampled after it)
+ * @param[in, out] geom geometry to add the transformed primitive representation of circle
+ */
+static void _circleToPrimitive(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *tag,
+  const srm::transform_t &transform, srm::geometry_t *geom) noexcept {
+  srm::vec_t c;
+  double r;
+  if (!_getCircle(ctx, tag, &c, &r))
+    return;
+
+  srm::vec_t
+    center = transform.TransformPoint(c),
+    axisX = transform.TransformVector(srm::vec_t(r, 0)),
+    axisY = transform.TransformVector(srm::vec_t(0, r));
+  if (_cullElement(ctx, srm::GetEllipseBbox(center, axisX, axisY)))
+    return;
+
+  ctx->stats.shapes++;
+  if (ctx->shapeCache.AddEllipse(center, axisX, axisY, ctx->roboConf.GetSvgAcc(), geom))
+    ctx->stats.shapeHits++;
 }
 
 /**
- * Transform svg rectangle to primitive
+ * Get corners of svg rectangle
+ * @param[in, out] ctx conversion context
  * @param[in] tag pointer to rectangle node in xml DOM
- * @param[out] rectanglePrimitive the primitive representations of rectangle
+ * @param[out] corners 4 corners of rectangle in drawing order
+ * @return true if rectangle is valid, false - otherwise
  */
-static void _rectToPrimitive(const rapidxml::xml_node<> *tag, srm::primitive_t *rectanglePrimitive) noexcept {
+static bool _getRect(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *tag, srm::vec_t *corners) noexcept {
   double x, y, height, width;
   const double defaultX = 0, defaultY = 0;
-  srm::translator_t *trans = srm::translator_t::GetPtr();
 
   if (tag->last_attribute("x")) {
-    try {
-      x = std::stod(tag->last_attribute("x")->value(), NULL);
-      if (std::string(tag->last_attribute("x")->value()).find("%") != std::string::npos) {
-        x = trans->roboConf.GetW() * x / 100;
-      }
-    }
-    catch (std::exception) {
-      trans->WriteLog("Warning: invalid attribute x in rect");
+    if (!srm::ParseLength(tag->last_attribute("x")->value(), ctx->roboConf.GetW(), &x)) {
+      ctx->WriteLog("Warning: invalid attribute x in rect");
       x = defaultX;
     }
   }
   else {
-    trans->WriteLog("Warning: attribute x in rect is not set");
+    ctx->WriteLog("Warning: attribute x in rect is not set");
     x = defaultX;
   }
 
   if (tag->last_attribute("y")) {
-    try {
-      y = std::stod(tag->last_attribute("y")->value(), NULL);
-      if (std::string(tag->last_attribute("y")->value()).find("%") != std::string::npos) {
-        y = trans->roboConf.GetH() * y / 100;
-      }
-    }
-    catch (std::exception) {
-      trans->WriteLog("Warning: invalid attribute y in rect");
+    if (!srm::ParseLength(tag->last_attribute("y")->value(), ctx->roboConf.GetH(), &y)) {
+      ctx->WriteLog("Warning: invalid attribute y in rect");
       y = defaultY;
     }
   }
   else {
-    trans->WriteLog("Warning: attribute y in rect is not set");
+    ctx->WriteLog("Warning: attribute y in rect is not set");
     y = defaultY;
   }
 
   if (tag->last_attribute("height")) {
-    height = strtod(tag->last_attribute("height")->value(), NULL);
-    if (height <= 0) {
-      trans->WriteLog("Warning: attribute height in rect must be more than 0");
-      return;
+    if (!srm::ParseLength(tag->last_attribute("height")->value(), ctx->roboConf.GetH(), &height)) {
+      ctx->WriteLog("Warning: invalid attribute height in rect");
+      return false;
     }
-    if (std::string(tag->last_attribute("height")->value()).find("%") != std::string::npos) {
-      height = trans->roboConf.GetH() * height / 100;
+    if (height <= 0) {
+      ctx->WriteLog("Warning: attribute height in rect must be more than 0");
+      return false;
     }
   }
   else {
-    trans->WriteLog("Warning: attribute height in rect is not set");
-    return;
+    ctx->WriteLog("Warning: attribute height in rect is not set");
+    return false;
   }
 
   if (tag->last_attribute("width")) {
-    width = std::stod(tag->last_attribute("width")->value(), NULL);
-    if (width <= 0) {
-      trans->WriteLog("Warning: attribute widtht in rect is less or equal to zero");
-      return;
+    if (!srm::ParseLength(tag->last_attribute("width")->value(), ctx->roboConf.GetW(), &width)) {
+      ctx->WriteLog("Warning: invalid attribute width in rect");
+      return false;
     }
-    if (std::string(tag->last_attribute("width")->value()).find("%") != std::string::npos) {
-      width = trans->roboConf.GetW() * width / 100;
+    if (width <= 0) {
+      ctx->WriteLog("Warning: attribute widtht in rect is less or equal to zero");
+      return false;
     }
   }
   else {
-    trans->WriteLog("Warning: attribute width in rect is not set");
-    return;
+    ctx->WriteLog("Warning: attribute width in rect is not set");
+    return false;
   }
 
   double rx = 0;
   double ry = 0;
 
   if (tag->last_attribute("rx")) {
-    try { 
-      rx = std::stod(tag->last_attribute("rx")->value(), NULL); 
-      if (std::string(tag->last_attribute("rx")->value()).find("%") != std::string::npos) {
-        rx = trans->roboConf.GetW() * rx / 100;
-      }
-    }
-    catch (std::exception) {
+    if (!srm::ParseLength(tag->last_attribute("rx")->value(), ctx->roboConf.GetW(), &rx)) {
       rx = -1;
     }
   }
   if (tag->last_attribute("ry")) {
-    try {
-      ry = std::stod(tag->last_attribute("ry")->value(), NULL);
-      if (std::string(tag->last_attribute("ry")->value()).find("%") != std::string::npos) {
-        ry = trans->roboConf.GetH() * ry / 100;
-      }
-    }
-    catch (std::exception) {
+    if (!srm::ParseLength(tag->last_attribute("ry")->value(), ctx->roboConf.GetH(), &ry)) {
       ry = -1;
     }
   }
   if (rx >= 0 && ry < 0) {
-    trans->WriteLog("Warning: wrong attribute ry in rect");
+    ctx->WriteLog("Warning: wrong attribute ry in rect");
     ry = rx;
   }
   else if (rx < 0 && ry >= 0) {
-    trans->WriteLog("Warning: wrong attribute rx in rect");
+    ctx->WriteLog("Warning: wrong attribute rx in rect");
     rx = ry;
   }
   else if (rx < 0 && ry < 0) {
-    trans->WriteLog("Warning: wrong attributes rx and ry in rect");
+    ctx->WriteLog("Warning: wrong attributes rx and ry in rect");
     rx = ry = 0;
   }
 
   if (rx > width / 2) {
     rx = width / 2;
-    trans->WriteLog("attribute rx in rect is more than half of width");
+    ctx->WriteLog("attribute rx in rect is more than half of width");
   }
   if (ry > height / 2) {
     rx = height/ 2;
-    trans->WriteLog("attribute ry in rect is more than half of height");
+    ctx->WriteLog("attribute ry in rect is more than half of height");
   }
 
   // TODO: realise processing rx and ry attributes in rect
 
+  corners[0] = srm::vec_t(x, y);
+  corners[1] = srm::vec_t(x + width, y);
+  corners[2] = srm::vec_t(x + width, y + height);
+  corners[3] = srm::vec_t(x, y + height);
+  return true;
+}
+
+/**
+ * Transform svg rectangle to primitive
+ * @param[in, out] ctx conversion context
+ * @param[in] tag pointer to rectangle node in xml DOM
+ * @param[in] transform transformation of rectangle to the final coordinates
+ * @param[in, out] geom geometry to add the primitive representation of rectangle
+ */
+static void _rectToPrimitive(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *tag,
+  const srm::transform_t &transform, srm::geometry_t *geom) noexcept {
+  srm::vec_t corners[4];
+  if (!_getRect(ctx, tag, corners) || _cullElement(ctx, _getBbox(transform, corners, 4)))
+    return;
+
   // Transform to primitive
-  rectanglePrimitive->start.x = x;
-  rectanglePrimitive->start.y = y;
-
-  srm::segment_t p1(x + width, y);
-  srm::segment_t p2(x + width, y + height);
-  srm::segment_t p3(x, y + height);
-  srm::segment_t p4(x, y);
-  rectanglePrimitive->push_back(p1);
-  rectanglePrimitive->push_back(p2);
-  rectanglePrimitive->push_back(p3);
-  rectanglePrimitive->push_back(p4);
+  for (const srm::vec_t &corner : corners)
+    geom->Add(corner);
+  geom->Add(corners[0]);
 }
 
 /**
- * Process and save svg width and height
+ * Process and save svg width and height. Sizes are lengths in user units like shape attributes,
+ * percents are taken of default size
+ * @param[in, out] ctx conversion context
  * @param[in] tag pointer to rectangle node in xml DOM
  */
-static void _processSvgParams(const rapidxml::xml_node<> *tag) noexcept {
+static void _processSvgParams(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *tag) noexcept {
   const double defaultWidth = 300, defaultHeight = 150;
   double width, height;
   if (tag->last_attribute("width")) {
-    width = strtod(tag->last_attribute("width")->value(), NULL);
-    if (width <= 0) {
+    if (!srm::ParseLength(tag->last_attribute("width")->value(), defaultWidth, &width)) {
+      width = defaultWidth;
+      ctx->WriteLog("Warning: invalid attribute width in svg");
+    }
+    else if (width <= 0) {
       width = defaultWidth;
-      srm::translator_t::GetPtr()->WriteLog("Warning: svg width must be more than 0");
+      ctx->WriteLog("Warning: svg width must be more than 0");
     }
   }
   else {
     width = defaultWidth;
-    srm::translator_t::GetPtr()->WriteLog("Warning: svg width is not set");
+    ctx->WriteLog("Warning: svg width is not set");
   }
   if (tag->last_attribute("height")) {
-    height = strtod(tag->last_attribute("height")->value(), NULL);
-    if (height <= 0) {
+    if (!srm::ParseLength(tag->last_attribute("height")->value(), defaultHeight, &height)) {
       height = defaultHeight;
-      srm::translator_t::GetPtr()->WriteLog("Warning: svg height must be more than 0");
+      ctx->WriteLog("Warning: invalid attribute height in svg");
+    }
+    else if (height <= 0) {
+      height = defaultHeight;
+      ctx->WriteLog("Warning: svg height must be more than 0");
     }
   }
   else {
     height = defaultHeight;
-    srm::translator_t::GetPtr()->WriteLog("Warning: svg height is not set");
+    ctx->WriteLog("Warning: svg height is not set");
   }
-  srm::translator_t::GetPtr()->roboConf.SetWH(width, height);
+  ctx->roboConf.SetWH(width, height);
 }
 
 /**
- * Transform svg tags to primitives
- * @param[in] tags the list of tags in DOM
- * @param[out] primitives the list of primitive representations of tags
+ * Check name of element function
+ * @param[in] node pointer to node in xml DOM
+ * @param[in] name name to compare with
+ * @return true if node has this name, false - otherwise
  */
-void srm::TagsToPrimitives(const std::list<srm::tag_t *> &tags, std::list<srm::primitive_t*> *primitives) noexcept {
-  std::string tagName;
-  std::list<transform_t> transformations;
-  transform_t transformCompos; ///< composition of all transformations
-  unsigned prevLevel = 0; ///< previoust level in svg tree
-
-  for (auto tag : tags) {
-    tagName.assign(tag->node->name(), tag->node->name_size());
-
-    if (tag->level < prevLevel) {
-      for (unsigned i = prevLevel; i > tag->level; --i)
-        transformations.pop_back();
-      
-      transformCompos.Clear();
-      for (const auto& transform : transformations)
-        transformCompos *= transform;
-
-      prevLevel = tag->level;
-    }
-
-    if (tagName == "g" && tag->level == prevLevel) {
-      transformations.pop_back();
-      transformCompos.Clear();
-      for (const auto& transform : transformations)
-        transformCompos *= transform;
-    }
-
-    if (tagName == "svg") {
-      _processSvgParams(tag->node);
-      transform_t transform;
-      auto attr = tag->node->first_attribute("transform");      
-      while (attr) {
-        transform *= transform_t(attr->value());
-        attr = attr->next_attribute("transform");
-      }
-      transformations.push_back(transform);
-
-      if (tag->node->first_attribute("transform")) {
-        transformCompos.Clear();
-        for (const auto& transform : transformations)
-          transformCompos *= transform;
-      }
-
-      prevLevel = tag->level;
-    }
-    else if (tagName == "g") {
-      transform_t transform;
-      auto attr = tag->node->first_attribute("transform");
-      while (attr) {
-        transform *= transform_t(attr->value());
-        attr = attr->next_attribute("transform");
-      }
-
-      transformations.push_back(transform);
-
-      if (tag->node->first_attribute("transform")) {
-        transformCompos.Clear();
-        for (const auto& transform : transformations)
-          transformCompos *= transform;
-      }
-      
-      prevLevel = tag->level;
-    }
-    else if (tagName == "path") {
-      srm::path_t path(primitives, transformCompos);
-      path.ParsePath(tag->node);
-    }
+static bool _isTag(const rapidxml::xml_node<> *node, const char *name) noexcept {
+  return node->name_size() == strlen(name) && strncmp(node->name(), name, node->name_size()) == 0;
+}
+
+/**
+ * Check if node is descendant of other node function
+ * @param[in] node pointer to node in xml DOM
+ * @param[in] ancestor pointer to possible ancestor node in xml DOM
+ * @return true if node is descendant of ancestor, false - otherwise
+ */
+static bool _isDescendant(const rapidxml::xml_node<> *node, const rapidxml::xml_node<> *ancestor) noexcept {
+  for (node = node->parent(); node != nullptr; node = node->parent())
+    if (node == ancestor)
+      return true;
+  return false;
+}
+
+/**
+ * Get bounding box of shape in the final coordinates without adding its primitive function
+ * @param[in, out] ctx conversion context
+ * @param[in] tag pointer to element node in xml DOM
+ * @param[in] ctm current transformation matrix of element
+ * @param[in, out] geom geometry (points of polylines and polygons are parsed to its open primitive and discarded)
+ * @return bounding box (min is more than max if element is not shape or is invalid)
+ */
+static srm::bbox_t _getShapeBbox(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *tag,
+  const srm::transform_t &ctm, srm::geometry_t *geom) noexcept {
+  srm::bbox_t bbox{srm::vec_t(HUGE_VAL, HUGE_VAL), srm::vec_t(-HUGE_VAL, -HUGE_VAL)};
+  if (_isTag(tag, "path")) {
+    if (tag->first_attribute("d") != nullptr)
+      bbox = srm::path_t(ctx, geom, ctm).GetBbox(tag);
+    return bbox;
+  }
+
+  srm::transform_t transform = ctm;
+  if (tag->first_attribute("transform") != nullptr)
+    transform *= srm::transform_t(ctx, tag);
+
+  srm::vec_t points[4], radiuses;
+  double r;
+  if (_isTag(tag, "rect")) {
+    if (_getRect(ctx, tag, points))
+      bbox = _getBbox(transform, points, 4);
+  }
+  else if (_isTag(tag, "circle")) {
+    if (_getCircle(ctx, tag, points, &r))
+      bbox = srm::GetEllipseBbox(transform.TransformPoint(points[0]),
+        transform.TransformVector(srm::vec_t(r, 0)), transform.TransformVector(srm::vec_t(0, r)));
+  }
+  else if (_isTag(tag, "ellipse")) {
+    if (_getEllipse(ctx, tag, points, &radiuses))
+      bbox = srm::GetEllipseBbox(transform.TransformPoint(points[0]),
+        transform.TransformVector(srm::vec_t(radiuses.x, 0)), transform.TransformVector(srm::vec_t(0, radiuses.y)));
+  }
+  else if (_isTag(tag, "line")) {
+    if (_getLine(ctx, tag, points))
+      bbox = _getBbox(transform, points, 2);
+  }
+  else if (_isTag(tag, "polyline") || _isTag(tag, "polygon")) {
+    size_t first = geom->GetOpenBegin();
+    if (_pointsToPrimitive(ctx, tag, tag->name(), geom))
+      for (size_t i = first; i < first + geom->GetOpenSize(); i++)
+        bbox.Add(transform.TransformPoint(geom->GetPoint(i)));
+    geom->Discard();
+  }
+  return bbox;
+}
+
+/**
+ * Check if all shapes of element children are out of sheet function. Check stops at the first shape on sheet,
+ * groups and shapes found out of sheet before it are kept in context to be skipped by conversion
+ * @param[in, out] ctx conversion context
+ * @param[in] node pointer to element node in xml DOM
+ * @param[in] ctm transformation of element children to the final coordinates
+ * @param[in, out] geom geometry (its open primitive is used as scratch)
+ * @return true if all children are out of sheet, false - otherwise
+ */
+static bool _isSubtreeOut(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *node,
+  const srm::transform_t &ctm, srm::geometry_t *geom) noexcept {
+  for (const rapidxml::xml_node<> *child = node->first_node(); child != nullptr; child = child->next_sibling()) {
+    if (child->type() != rapidxml::node_element)
+      continue;
+
+    if (_isTag(child, "g")) {
+      srm::transform_t transform = ctm;
+      if (child->first_attribute("transform") != nullptr)
+        transform *= srm::transform_t(ctx, child);
+      if (!_isSubtreeOut(ctx, child, transform, geom))
+        return false;
+    }
+    // nested svg changes sheet size, so it is always converted
+    else if (_isTag(child, "svg"))
+      return false;
     else {
-      srm::primitive_t *primitive = new srm::primitive_t();
-      if (tagName == "rect") {
-        _rectToPrimitive(tag->node, primitive);
-      }
-      else if (tagName == "circle") {
-        _circleToPrimitive(tag->node, primitive);
-      }
-      else if (tagName == "ellipse") {
-        _ellipseToPrimitive(tag->node, primitive);
-      }
-      else if (tagName == "line") {
-        _lineToPrimitive(tag->node, primitive);
-      }
-      else if (tagName == "polyline") {
-        _polylineToPrimitive(tag->node, primitive);
-      }
-      else if (tagName == "polygon") {
-        _polygonToPrimitive(tag->node, primitive);
-      }
-      else if (tagName == "text") {
-        // TODO: realise text processing
-      }
-
-      if (primitive->size() > 0) {
-        transform_t transform;
-        auto attr = tag->node->first_attribute("transform");
-        while(attr) {
-          transform *= transform_t(attr->value());
-          attr = attr->next_attribute("transform");
-        }
-        if (tag->node->first_attribute("transform")) {
-          transform.Apply(primitive);
-        }
-        transformCompos.Apply(primitive);
-
-        primitive->fill = IsFill(tag->node);
-
-        primitives->push_back(primitive);
-      }
+      srm::bbox_t bbox = _getShapeBbox(ctx, child, ctm, geom);
+      // children of other elements are converted in coordinates of their parent
+      if (!bbox.IsOut(ctx->roboConf.GetW(), ctx->roboConf.GetH()) || !_isSubtreeOut(ctx, child, ctm, geom))
+        return false;
+      // invalid shapes have no geometry, they are left to conversion to write their warnings
+      if (bbox.min.x > bbox.max.x)
+        continue;
+    }
+    ctx->culledNodes.insert(child);
+  }
+  return true;
+}
+
+/**
+ * Get transformation of node children to the final coordinates function
+ * @param[in, out] ctx conversion context
+ * @param[in] node pointer to node in xml DOM
+ * @return composition of transformations of node and all enclosing groups
+ */
+static srm::transform_t _getCtm(srm::conversion_context_t *ctx, const rapidxml::xml_node<> *node) noexcept {
+  if (node == nullptr)
+    return srm::transform_t();
+
+  srm::transform_t ctm = _getCtm(ctx, node->parent());
+  if ((_isTag(node, "g") || _isTag(node, "svg")) && node->first_attribute("transform") != nullptr)
+    ctm *= srm::transform_t(ctx, node);
+  return ctm;
+}
+
+/**
+ * Constructor for tags_translator_t
+ * @param[in, out] c conversion context
+ * @param[out] g geometry to add primitive representations of tags
+ */
+srm::tags_translator_t::tags_translator_t(conversion_context_t *c, geometry_t *g) noexcept :
+  ctx(c), geom(g), ctms(1), prevLevel(0) {
+}
+
+/**
+ * Transform next svg tag in document order to primitives
+ * @param[in] tag tag to transform
+ */
+void srm::tags_translator_t::Process(const srm::tag_t &tag) noexcept {
+  tagName.assign(tag.node->name(), tag.node->name_size());
+
+  if (tag.level < prevLevel) {
+    // the root matrix is never removed
+    for (unsigned i = prevLevel; i > tag.level && ctms.size() > 1; --i)
+      ctms.pop_back();
+    prevLevel = tag.level;
+  }
+
+  if (tagName == "g" && tag.level == prevLevel && ctms.size() > 1)
+    ctms.pop_back();
+
+  if (tagName == "svg" || tagName == "g") {
+    if (tagName == "svg")
+      _processSvgParams(ctx, tag.node);
+    ctms.push_back(ctms.back());
+    if (tag.node->first_attribute("transform") != nullptr)
+      ctms.back() *= transform_t(ctx, tag.node);
+    prevLevel = tag.level;
+  }
+  else if (tagName == "path") {
+    size_t first = geom->Size();
+    srm::path_t path(ctx, geom, ctms.back());
+    path.ParsePath(tag.node);
+    _cullPrimitives(ctx, geom, first);
+  }
+  else {
+    // own transformation of tag is fused with the current one to transform points in one pass
+    transform_t transform = ctms.back();
+    if (tag.node->first_attribute("transform") != nullptr)
+      transform *= transform_t(ctx, tag.node);
+
+    // curved shapes are sampled after transformation to keep accuracy in the final coordinates
+    bool isTransformed = false;
+    size_t first = geom->GetOpenBegin();
+    if (tagName == "rect") {
+      _rectToPrimitive(ctx, tag.node, transform, geom);
+    }
+    else if (tagName == "circle") {
+      _circleToPrimitive(ctx, tag.node, transform, geom);
+      isTransformed = true;
+    }
+    else if (tagName == "ellipse") {
+      _ellipseToPrimitive(ctx, tag.node, transform, geom);
+      isTransformed = true;
+    }
+    else if (tagName == "line") {
+      _lineToPrimitive(ctx, tag.node, transform, geom);
+    }
+    else if (tagName == "polyline") {
+      _polylineToPrimitive(ctx, tag.node, geom);
+    }
+    else if (tagName == "polygon") {
+      _polygonToPrimitive(ctx, tag.node, geom);
+    }
+    else if (tagName == "text") {
+      // TODO: realise text processing
+    }
+
+    // primitive must contain at least one segment
+    if (geom->GetOpenSize() > 1) {
+      if (!isTransformed)
+        transform.Apply(geom, first);
+
+      // points of polylines and polygons are parsed before their bounding box is known
+      if ((tagName == "polyline" || tagName == "polygon") && _cullOpenPrimitive(ctx, *geom))
+        geom->Discard();
       else
-        delete primitive;
+        geom->Close(GetFillFlags(ctx->roboConf, tag.node));
     }
+    else
+      geom->Discard();
   }
-}
\ No newline at end of file
+}
+
+/**
+ * Transform svg tags to primitives. Groups out of sheet are skipped with their subtrees
+ * @param[in, out] ctx conversion context
+ * @param[in] tags the list of tags in DOM
+ * @param[out] geom geometry to add primitive representations of tags
+ */
+void srm::TagsToPrimitives(conversion_context_t *ctx, const std::vector<srm::tag_t *> &tags, geometry_t *geom) noexcept {
+  tags_translator_t translator(ctx, geom);
+  std::ostream *log = ctx->GetLog(), quiet(nullptr);
+
+  for (size_t i = 0; i < tags.size(); i++) {
+    const rapidxml::xml_node<> *node = tags[i]->node;
+
+    // whole DOM is known, so group out of sheet is skipped with its subtree before parsing of its shapes
+    // (shapes are checked quietly, warnings are written by conversion of shapes which are not skipped)
+    bool isCulled = !ctx->culledNodes.empty() && ctx->culledNodes.count(node) != 0;
+    if (!isCulled && _isTag(node, "g")) {
+      ctx->SetLog(&quiet);
+      isCulled = _isSubtreeOut(ctx, node, _getCtm(ctx, node), geom);
+      ctx->SetLog(log);
+    }
+    if (!isCulled) {
+      translator.Process(*tags[i]);
+      continue;
+    }
+
+    // tags of subtree follow its root in document order
+    if (!_isTag(node, "g"))
+      ctx->stats.culledElements++;
+    while (i + 1 < tags.size() && _isDescendant(tags[i + 1]->node, node)) {
+      i++;
+      if (tags[i]->node->type() == rapidxml::node_element && !_isTag(tags[i]->node, "g"))
+        ctx->stats.culledElements++;
+    }
+  }
+}
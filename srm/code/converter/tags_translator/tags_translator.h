@@ -13,16 +13,48 @@
 #define __TAGS_TRANSLATOR_H_INCLUDED
 
 #include <srm.h>
-#include <list>
+#include <string>
+#include <vector>
 
 /** \brief Project namespace */
 namespace srm {
   /**
-   * Transform svg tags to primitives
+   * @brief Tags translation class
+   *
+   * Transforms svg tags to primitives one by one in document order keeping stack of precomposed transformations
+   * of groups, so opening and closing group costs one matrix product regardless of nesting depth
+   */
+  class tags_translator_t {
+  private:
+    conversion_context_t *ctx;                  ///< conversion context
+    geometry_t *geom;                           ///< geometry to add primitive representations of tags
+    std::vector<transform_t> ctms;              ///< current transformation matrices: the root one and one for each opened group
+                                                ///< (composition of transformations of all enclosing groups)
+    unsigned prevLevel;                         ///< previous level in svg tree
+    std::string tagName;                        ///< name of the current tag
+
+  public:
+    /**
+     * Constructor for tags_translator_t
+     * @param[in, out] c conversion context
+     * @param[out] g geometry to add primitive representations of tags
+     */
+    tags_translator_t(conversion_context_t *c, geometry_t *g) noexcept;
+
+    /**
+     * Transform next svg tag in document order to primitives
+     * @param[in] tag tag to transform
+     */
+    void Process(const srm::tag_t &tag) noexcept;
+  };
+
+  /**
+   * Transform svg tags to primitives. Groups out of sheet are skipped with their subtrees
+   * @param[in, out] ctx conversion context
    * @param[in] tags the list of tags in DOM
-   * @param[out] primitives the list of primitive representations of tags
+   * @param[out] geom geometry to add primitive representations of tags
    */
-  void TagsToPrimitives(const std::list<srm::tag_t *> &tags, std::list<srm::primitive_t *> *primitives) noexcept;
+  void TagsToPrimitives(conversion_context_t *ctx, const std::vector<srm::tag_t *> &tags, geometry_t *geom) noexcept;
 }
 
 #endif /* __TAGS_TRANSLATOR_H_INCLUDED */
@@ -9,9 +9,8 @@
 
 #include <srm.h>
 
-#include <list>
-#include <sstream>
-#include <cstdarg>
+#include <cmath>
+#include <cstring>
 
 /**
  * Default constructor
@@ -19,243 +18,140 @@
 srm::transform_t::transform_t() noexcept {
 }
 
-static bool _getArgs(const std::string &attrStr, size_t pos, size_t *newPos, int n, ...) {
-  size_t bracketPos = attrStr.find('(', pos);
-  if (bracketPos == std::string::npos)
-    return false;
-
-  for (auto i = pos; i < bracketPos; ++i)
-    if (!isspace(attrStr[i]))
-      return false;
- 
-  pos = bracketPos + 1;
-  bracketPos = attrStr.find(')', pos);
-  if (bracketPos == std::string::npos)
-    return false;
-
-  for (auto i = pos; i < bracketPos; ++i)
-    if (!isspace(attrStr[i]) && !isdigit(attrStr[i]) && attrStr[i] != '-' && attrStr[i] != '.')
-      return false;
-
-  *newPos = bracketPos;
-
-  std::istringstream vals(attrStr.substr(pos, bracketPos - pos));
+/**
+ * Get arguments of transformation in brackets
+ * @param[in] str position after transformation name
+ * @param[out] args arguments
+ * @param[in] maxNum maximal number of arguments
+ * @param[out] num number of arguments
+ * @return position after closing bracket, nullptr if arguments are invalid
+ */
+static const char * _getArgs(const char *str, double *args, size_t maxNum, size_t *num) noexcept {
+  str = srm::SkipSpaces(str);
+  if (*str != '(')
+    return nullptr;
+  str = srm::SkipSpaces(str + 1);
+
+  *num = 0;
+  if (*str == ')')
+    return str + 1;
+  while (true) {
+    if (*num == maxNum || (str = srm::ParseNumber(str, args + *num)) == nullptr)
+      return nullptr;
+    ++*num;
+    str = srm::SkipSpaces(str);
+    if (*str == ')')
+      return str + 1;
+    if (*str == ',')
+      str = srm::SkipSpaces(str + 1);
+  }
+}
 
-  va_list args;
-  va_start(args, n);
+/**
+ * Check if string starts with transformation name
+ * @param[in] str string
+ * @param[in] name transformation name
+ * @return true if name is prefix of string, false - otherwise
+ */
+static bool _isName(const char *str, const char *name) noexcept {
+  return strncmp(str, name, strlen(name)) == 0;
+}
 
-  if (n == 1) {
-    vals >> *va_arg(args, double*);
-    if (vals.fail()) {
-      va_end(args);
-      return false;
-    }
-  }
-  else if (n == 2) {
-    double x, y;
-    vals >> x;
-    if (vals.fail()) {
-      va_end(args);
-      return false;
+/**
+ * Parse svg transform attribute function
+ * @param[in] transAttr string with svg transform attibute value
+ * @param[out] res parsed transformation (is not changed if attribute is invalid)
+ * @return true if attribute is valid, false - otherwise
+ */
+bool srm::transform_t::Parse(const char *transAttr, transform_t *res) noexcept {
+  const size_t maxNumOfArgs = 6;
+  transform_t compos;
+  double args[maxNumOfArgs];
+  size_t num = 0;
+  const char *str = SkipSpaces(transAttr);
+
+  while (*str != '\0') {
+    transform_t transform;
+    bool isValid = false;
+    if (_isName(str, "matrix")) {
+      str = _getArgs(str + 6, args, maxNumOfArgs, &num);
+      if ((isValid = str != nullptr && num == 6))
+        transform.SetMatrix(args[0], args[2], args[4], args[1], args[3], args[5]);
     }
-    vals >> y;
-    if (vals.fail()) {
-      y = 0;
-      *va_arg(args, double*) = x;
-      *va_arg(args, double*) = y;
-      va_end(args);
-      return false;
+    else if (_isName(str, "translate")) {
+      str = _getArgs(str + 9, args, maxNumOfArgs, &num);
+      if ((isValid = str != nullptr && (num == 1 || num == 2)))
+        transform.SetMatrix(1, 0, args[0], 0, 1, num == 2 ? args[1] : 0);
     }
-    *va_arg(args, double*) = x;
-    *va_arg(args, double*) = y;
-  }
-  else if (n == 3) {
-    double a, x, y;
-
-    vals >> a;
-    if (vals.fail()) {
-      va_end(args);
-      return false;
+    else if (_isName(str, "scale")) {
+      str = _getArgs(str + 5, args, maxNumOfArgs, &num);
+      if ((isValid = str != nullptr && (num == 1 || num == 2)))
+        transform.SetMatrix(args[0], 0, 0, 0, num == 2 ? args[1] : args[0], 0);
     }
-    
-    vals >> x;
-    if (vals.fail())
-      x = y = 0;
-    else {
-      vals >> y;
-      if (vals.fail()) {
-        va_end(args);
-        return false;
+    else if (_isName(str, "rotate")) {
+      str = _getArgs(str + 6, args, maxNumOfArgs, &num);
+      if ((isValid = str != nullptr && (num == 1 || num == 3))) {
+        double
+          angle = args[0] * srm::pi / 180.0,
+          x = num == 3 ? args[1] : 0,
+          y = num == 3 ? args[2] : 0;
+        transform_t translate;
+        transform_t translateBack;
+        translate.SetMatrix(1, 0, x, 0, 1, y);
+        transform.SetMatrix(cos(angle), -sin(angle), 0, sin(angle), cos(angle), 0);
+        translateBack.SetMatrix(1, 0, -x, 0, 1, -y);
+        compos *= translate;
+        compos *= transform;
+        transform = translateBack;
       }
     }
-    
-    *va_arg(args, double*) = a;
-    *va_arg(args, double*) = x;
-    *va_arg(args, double*) = y;
-  }
-  else {
-    while (n--)
-      vals >> *va_arg(args, double*);
+    else if (_isName(str, "skewX")) {
+      str = _getArgs(str + 5, args, maxNumOfArgs, &num);
+      if ((isValid = str != nullptr && num == 1))
+        transform.SetMatrix(1, tan(args[0] * srm::pi / 180.0), 0, 0, 1, 0);
+    }
+    else if (_isName(str, "skewY")) {
+      str = _getArgs(str + 5, args, maxNumOfArgs, &num);
+      if ((isValid = str != nullptr && num == 1))
+        transform.SetMatrix(1, 0, 0, tan(args[0] * srm::pi / 180.0), 1, 0);
+    }
 
-    if (vals.fail()) {
-      va_end(args);
+    if (!isValid)
       return false;
-    }
+    compos *= transform;
+    str = SkipSeparator(str);
   }
 
-  va_end(args);
-
-  std::string check;
-  vals >> check;
-  return check == "";
+  *res = compos;
+  return true;
 }
 
 /**
  * Constuctor from svg attribute
+ * @param[in, out] ctx conversion context to make logs
  * @param[in] trnsAttr string with svg transform attibute value
  */
-srm::transform_t::transform_t(std::string transAttr) noexcept {
-
-  for (size_t i = 0; i < transAttr.length(); ++i)
-    if (transAttr[i] == ',')
-      transAttr[i] = ' ';
-
-  translator_t* trans = translator_t::GetPtr();
-  std::list<transform_t> transforms;
-  std::string type;
+srm::transform_t::transform_t(conversion_context_t *ctx, const char *transAttr) noexcept {
+  if (!Parse(transAttr, this))
+    ctx->WriteLog("Warning: invalid transform attribute");
+}
 
-  for (size_t i = 0; i < transAttr.length(); ++i) {
-    if (transAttr[i] == 'm') {
-      type = transAttr.substr(i, 6);
-      if (type == "matrix") {
-        i += 6;
-        double a, b, c, d, e, f;
-        if (_getArgs(transAttr, i, &i, 6, &a, &b, &c, &d, &e, &f)) {
-          transform_t matrixTransform;
-          matrixTransform.SetMatrix(a, c, e, b, d, f);
-          transforms.push_back(matrixTransform);
-        }
-        else {
-          trans->WriteLog("Warning: invalid transform attribute");
-          return;
-        }
-      }
-      else {
-        trans->WriteLog("Warning: invalid transform attribute");
-        return;
-      }
-    }
-    else if (transAttr[i] == 't') {
-      type = transAttr.substr(i, 9);
-      if (type == "translate") {
-        i += 9;
-        double x, y = 1;
-        if (_getArgs(transAttr, i, &i, 2, &x, &y)) {
-          transform_t translateTransform;
-          translateTransform.SetMatrix(1, 0, x, 0, 1, y);
-          transforms.push_back(translateTransform);
-        }
-        else if (y == 0) {
-          transform_t translateTransform;
-          translateTransform.SetMatrix(1, 0, x, 0, 1, y);
-          transforms.push_front(translateTransform);
-        }
-        else {
-          trans->WriteLog("Warning: invalid transform attribute");
-          return;
-        }
-      }
-      else {
-        trans->WriteLog("Warning: invalid transform attribute");
-        return;
-      }
-    }
-    else if (transAttr[i] == 'r') {
-      type = transAttr.substr(i, 6);
-      if (type == "rotate") {
-        i += 6;
-        double angle, x, y;
-        if (_getArgs(transAttr, i, &i, 3, &angle, &x, &y)) {
-          transform_t translate;
-          transform_t rotate;
-          transform_t translateBack;
-          angle = angle * srm::pi / 180.0;
-          translate.SetMatrix(1, 0, x, 0, 1, y);
-          rotate.SetMatrix(cos(angle), -sin(angle), 0, sin(angle), cos(angle), 0);
-          translateBack.SetMatrix(1, 0, -x, 0, 1,- y);
-          transforms.push_back(translate);
-          transforms.push_back(rotate);
-          transforms.push_back(translateBack);
-        }
-        else {
-          trans->WriteLog("Warning: invalid transform attribute");
-          return;
-        }
-      }
-      else {
-        trans->WriteLog("Warning: invalid transform attribute");
-        return;
-      }
-    }
-    else if (transAttr[i] == 's') {
-      type = transAttr.substr(i, 5);
-      i += 5;
-      if (type == "scale") {
-        double x, y = 1;
-        if (_getArgs(transAttr, i, &i, 2, &x, &y)) {
-          transform_t scaleTransform;
-          scaleTransform.SetMatrix(x, 0, 0, 0, y, 0);
-          transforms.push_back(scaleTransform);
-        }
-        else if (y == 0) {
-          transform_t scaleTransform;
-          scaleTransform.SetMatrix(x, 0, 0, 0, x, 0);
-          transforms.push_back(scaleTransform);
-        }
-        else {
-          trans->WriteLog("Warning: invalid transform attribute");
-          return;
-        }
-      }
-      else if (type == "skewX") {
-        double angle;
-        if (_getArgs(transAttr, i, &i, 1, &angle)) {
-          transform_t skewXTransform;
-          angle = angle * srm::pi / 180.0;
-          skewXTransform.SetMatrix(1, tan(angle), 0, 0, 1, 0);
-          transforms.push_back(skewXTransform);
-        }
-        else {
-          trans->WriteLog("Warning: invalid transform attribute");
-          return;
-        }
-      }
-      else if (type == "skewY") {
-        double angle;
-        if (_getArgs(transAttr, i, &i, 1, &angle)) {
-          transform_t skewYTransform;
-          angle = angle * srm::pi / 180.0;
-          skewYTransform.SetMatrix(1, 0, 0, tan(angle), 1, 0);
-          transforms.push_back(skewYTransform);
-        }
-        else {
-          trans->WriteLog("Warning: invalid transform attribute");
-          return;
-        }
-      }
-      else{
-        trans->WriteLog("Warning: invalid transform attribute");
-        return;
-      }
+/**
+ * Constuctor from all transform attributes of tag (identity if there are no attributes).
+ * Attributes are taken from context cache of parsed attributes
+ * @param[in, out] ctx conversion context to make logs
+ * @param[in] tag pointer to node in xml DOM
+ */
+srm::transform_t::transform_t(conversion_context_t *ctx, const rapidxml::xml_node<> *tag) noexcept {
+  for (auto attr = tag->first_attribute("transform"); attr != nullptr; attr = attr->next_attribute("transform")) {
+    // cache may fail to allocate its entry, then attribute is parsed without cache
+    try {
+      *this *= ctx->transforms.Get(ctx, attr->value(), attr->value_size());
     }
-    else if (!isspace(transAttr[i])) {
-      trans->WriteLog("Warning: invalid transform attribute");
-      return;
+    catch (std::exception &) {
+      *this *= transform_t(ctx, attr->value());
     }
   }
-
-  for (auto transform : transforms)
-    *this *= transform;
 }
 
 /**
@@ -270,6 +166,7 @@ void srm::transform_t::SetMatrix(double m00, double m01, double m02, double m10,
   matrix[1][0] = m10;
   matrix[1][1] = m11;
   matrix[1][2] = m12;
+  Classify();
 }
 
 /**
@@ -287,23 +184,60 @@ void srm::transform_t::operator*=(transform_t transform) noexcept {
   matrix[1][0] = tmp[1][0] * transform.matrix[0][0] + tmp[1][1] * transform.matrix[1][0];
   matrix[1][1] = tmp[1][0] * transform.matrix[0][1] + tmp[1][1] * transform.matrix[1][1];
   matrix[1][2] = tmp[1][0] * transform.matrix[0][2] + tmp[1][1] * transform.matrix[1][2] + tmp[1][2];
-} 
+  Classify();
+}
 
 /**
-  * Apply transformation to primitive
-  * @param[in] primitive primitive to transform
-  */
-void srm::transform_t::Apply(srm::primitive_t *primitive) const noexcept {
-  double tmp;
-
-  tmp = primitive->start.x;
-  primitive->start.x = matrix[0][0] * primitive->start.x + matrix[0][1] * primitive->start.y + matrix[0][2];
-  primitive->start.y = matrix[1][0] * tmp + matrix[1][1] * primitive->start.y + matrix[1][2];
+ * Evaluate kind of transformation by matrix function
+ */
+void srm::transform_t::Classify(void) noexcept {
+  bool
+    isAxisAligned = matrix[0][1] == 0 && matrix[1][0] == 0,
+    hasTranslation = matrix[0][2] != 0 || matrix[1][2] != 0,
+    hasScale = matrix[0][0] != 1 || matrix[1][1] != 1;
+
+  if (!isAxisAligned)
+    kind = kind_t::general;
+  else if (hasScale)
+    kind = hasTranslation ? kind_t::axisAligned : kind_t::scale;
+  else
+    kind = hasTranslation ? kind_t::translate : kind_t::identity;
+}
 
-  for (auto &segment : *primitive) {
-    tmp = segment.point.x;
-    segment.point.x = matrix[0][0] * segment.point.x + matrix[0][1] * segment.point.y + matrix[0][2];
-    segment.point.y = matrix[1][0] * tmp + matrix[1][1] * segment.point.y + matrix[1][2];
+/**
+  * Apply transformation to points of geometry
+  * @param[in, out] geom geometry to transform
+  * @param[in] first index of the first point to transform (points are transformed up to the end)
+  */
+void srm::transform_t::Apply(srm::geometry_t *geom, size_t first) const noexcept {
+  double *x = geom->x.data(), *y = geom->y.data();
+  size_t size = geom->x.size();
+
+  // terms with zero coefficients are skipped, so results are the same as by full multiplication
+  switch (kind) {
+  case kind_t::identity:
+    break;
+  case kind_t::translate:
+    for (size_t i = first; i < size; i++) {
+      x[i] += matrix[0][2];
+      y[i] += matrix[1][2];
+    }
+    break;
+  case kind_t::scale:
+    for (size_t i = first; i < size; i++) {
+      x[i] *= matrix[0][0];
+      y[i] *= matrix[1][1];
+    }
+    break;
+  case kind_t::axisAligned:
+    for (size_t i = first; i < size; i++) {
+      x[i] = matrix[0][0] * x[i] + matrix[0][2];
+      y[i] = matrix[1][1] * y[i] + matrix[1][2];
+    }
+    break;
+  case kind_t::general:
+    kernels::Affine(matrix, x + first, y + first, size - first);
+    break;
   }
 }
 
@@ -317,4 +251,5 @@ void srm::transform_t::Clear() noexcept {
   matrix[1][0] = 0;
   matrix[1][1] = 1;
   matrix[1][2] = 0;
+  kind = kind_t::identity;
 }
@@ -12,17 +12,42 @@
 #ifndef __TRANSFORM_H_INCLUDED
 #define __TRANSFORM_H_INCLUDED
 
+#include <cstddef>
+#include "../../rapidxml.hpp"
+#include "../../geometry/geometry.h"
+
 /** \brief Project namespace */
 namespace srm {
+  class conversion_context_t;
+
   /**
    * @brief transform_t class
    *
    * Class to process tags with attribute "transform"
    */
   class transform_t {
+  public:
+    /**
+     * @brief Kind of transformation to choose apply kernel
+     */
+    enum class kind_t {
+      identity,     ///< points are not changed
+      translate,    ///< translation only
+      scale,        ///< scale by axes only
+      axisAligned,  ///< scale by axes and translation
+      general       ///< general affine transformation
+    };
+
   private:
     double matrix[2][3] = { {1, 0, 0}, 
                             {0, 1, 0} };
+    kind_t kind = kind_t::identity;  ///< kind of transformation by matrix
+
+    /**
+     * Evaluate kind of transformation by matrix function
+     */
+    void Classify(void) noexcept;
+
   public:
     /**
      * Default constructor
@@ -31,9 +56,25 @@ namespace srm {
 
     /**
      * Constuctor from svg attribute
+     * @param[in, out] ctx conversion context to make logs
      * @param[in] trnsAttr string with svg transform attibute value
      */
-    transform_t(std::string transAttr) noexcept;
+    transform_t(conversion_context_t *ctx, const char *transAttr) noexcept;
+
+    /**
+     * Constuctor from all transform attributes of tag (identity if there are no attributes)
+     * @param[in, out] ctx conversion context to make logs
+     * @param[in] tag pointer to node in xml DOM
+     */
+    transform_t(conversion_context_t *ctx, const rapidxml::xml_node<> *tag) noexcept;
+
+    /**
+     * Parse svg transform attribute function
+     * @param[in] transAttr string with svg transform attibute value
+     * @param[out] res parsed transformation (is not changed if attribute is invalid)
+     * @return true if attribute is valid, false - otherwise
+     */
+    static bool Parse(const char *transAttr, transform_t *res) noexcept;
 
     /**
      * Set transformation matrix;
@@ -48,10 +89,50 @@ namespace srm {
     void operator*=(transform_t transform) noexcept;
 
     /**
-     * Apply transformation to primitive
-     * @param[in] primitive primitive to transform
+     * Apply transformation to points of geometry
+     * @param[in, out] geom geometry to transform
+     * @param[in] first index of the first point to transform (points are transformed up to the end)
+     */
+    void Apply(srm::geometry_t *geom, size_t first) const noexcept;
+
+    /**
+     * Transform point function (the result is the same as by Apply)
+     * @param[in] p point
+     * @return transformed point
+     */
+    vec_t TransformPoint(const vec_t &p) const noexcept {
+      switch (kind) {
+      case kind_t::identity:
+        return p;
+      case kind_t::translate:
+        return vec_t(p.x + matrix[0][2], p.y + matrix[1][2]);
+      case kind_t::scale:
+        return vec_t(p.x * matrix[0][0], p.y * matrix[1][1]);
+      case kind_t::axisAligned:
+        return vec_t(matrix[0][0] * p.x + matrix[0][2], matrix[1][1] * p.y + matrix[1][2]);
+      default:
+        return vec_t(matrix[0][0] * p.x + matrix[0][1] * p.y + matrix[0][2],
+          matrix[1][0] * p.x + matrix[1][1] * p.y + matrix[1][2]);
+      }
+    }
+
+    /**
+     * Transform vector (difference of points, translation is not applied) function
+     * @param[in] v vector
+     * @return transformed vector
      */
-    void Apply(srm::primitive_t *primitive) const noexcept;
+    vec_t TransformVector(const vec_t &v) const noexcept {
+      switch (kind) {
+      case kind_t::identity:
+      case kind_t::translate:
+        return v;
+      case kind_t::scale:
+      case kind_t::axisAligned:
+        return vec_t(matrix[0][0] * v.x, matrix[1][1] * v.y);
+      default:
+        return vec_t(matrix[0][0] * v.x + matrix[0][1] * v.y, matrix[1][0] * v.x + matrix[1][1] * v.y);
+      }
+    }
 
     /**
      * Set identity transformation
@@ -0,0 +1,43 @@
+/**
+ * @file
+ * @brief Transform attributes cache class source file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains transform_cache_t class realisation to parse each distinct transform attribute once per conversion
+ */
+
+#include <srm.h>
+
+/**
+ * Get transformation of attribute function
+ * @param[in, out] ctx conversion context to make logs
+ * @param[in] transAttr string with svg transform attibute value
+ * @param[in] size length of attribute value
+ * @return transformation (identity if attribute is invalid)
+ */
+const srm::transform_t & srm::transform_cache_t::Get(conversion_context_t *ctx, const char *transAttr, size_t size) {
+  // limits memory for documents where all attributes are different
+  const size_t maxNumOfEntries = 1 << 16;
+
+  key.assign(transAttr, size);
+  auto found = entries.find(key);
+  if (found == entries.end()) {
+    entry_t entry;
+    entry.isValid = transform_t::Parse(key.c_str(), &entry.transform);
+    if (entries.size() == maxNumOfEntries)
+      entries.clear();
+    found = entries.emplace(key, entry).first;
+  }
+
+  if (!found->second.isValid)
+    ctx->WriteLog("Warning: invalid transform attribute");
+  return found->second.transform;
+}
+
+/**
+ * Remove all transformations function
+ */
+void srm::transform_cache_t::Clear(void) noexcept {
+  entries.clear();
+}
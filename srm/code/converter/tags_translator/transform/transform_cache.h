@@ -0,0 +1,58 @@
+/**
+ * @file
+ * @brief Transform attributes cache class header file
+ * @authors Vorotnikov Andrey
+ * @date 15.10.2026
+ *
+ * Contains transform_cache_t class description to parse each distinct transform attribute once per conversion
+ */
+
+#pragma once
+
+#ifndef __TRANSFORM_CACHE_H_INCLUDED
+#define __TRANSFORM_CACHE_H_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include "transform.h"
+
+/** \brief Project namespace */
+namespace srm {
+  /**
+   * @brief Transform attributes cache class
+   *
+   * Interns parsed transformations by attribute text: real files repeat the same transform attribute
+   * for thousands of elements, so it is parsed only at the first meeting
+   */
+  class transform_cache_t {
+  private:
+    /**
+     * @brief Parsed attribute struct
+     */
+    struct entry_t {
+      transform_t transform;  ///< parsed transformation (identity if attribute is invalid)
+      bool isValid;           ///< true if attribute is valid
+    };
+
+    std::unordered_map<std::string, entry_t> entries;  ///< parsed attributes by text
+    std::string key;                                   ///< key buffer reused by lookups
+
+  public:
+    /**
+     * Get transformation of attribute function
+     * @param[in, out] ctx conversion context to make logs
+     * @param[in] transAttr string with svg transform attibute value
+     * @param[in] size length of attribute value
+     * @return transformation (identity if attribute is invalid)
+     */
+    const transform_t & Get(conversion_context_t *ctx, const char *transAttr, size_t size);
+
+    /**
+     * Remove all transformations function
+     */
+    void Clear(void) noexcept;
+  };
+}
+
+#endif /* __TRANSFORM_CACHE_H_INCLUDED */
@@ -14,28 +14,11 @@
 #include <string>
 #include <iostream>
 
-srm::translator_t srm::translator_t::singleToneVar;  ///< tranlator singletone variable
-
-/**
- * Private constructor for single tone
- */
-srm::translator_t::translator_t(void) noexcept : logStream(&std::cout) {
-}
-
-/**
- * Get 'translator_t' class single tone variable
- * @return pointer to single tone variable
- */
-srm::translator_t * srm::translator_t::GetPtr(void) noexcept {
-  return &singleToneVar;
-}
-
 /**
- * Write string in log stream function
- * @param[in] str string to write
+ * Constructor for translator_t
+ * @param[in] log stream to make logs
  */
-void srm::translator_t::WriteLog(const std::string &str) noexcept {
-  *logStream << str << std::endl;
+srm::translator_t::translator_t(std::ostream *log) noexcept : context(log) {
 }
 
 /**
@@ -43,24 +26,21 @@ void srm::translator_t::WriteLog(const std::string &str) noexcept {
  * @param[in] svgFileName path to file with svg image
  */
 void srm::translator_t::SetSvg(const std::string &svgFileName) {
-  std::ifstream fin(svgFileName);
-  if (!fin.is_open()) {
-    throw std::exception("Failed to open intput file");
-  }
-
-  std::string buf;
-  std::string line;
-  while (std::getline(fin, line)) {
-    buf += line;
-  }
-
-  // this char string have to be in the heap during rapidxml works
-  xmlString = new char[buf.length() + 1];
+  svg_file_t file;
+  file.Load(svgFileName);
+  SetSvg(std::move(file));
+}
 
-  strcpy_s(xmlString, (buf.length() + 1) * sizeof(char), buf.c_str());
+/**
+ * Set already loaded svg image to convert function. Create tag tree
+ * @param[in] file loaded svg file (is moved to translator)
+ */
+void srm::translator_t::SetSvg(svg_file_t &&file) {
+  context.xmlTree.clear();
+  context.svgFile = std::move(file);
 
   try {
-    xmlTree.parse<rapidxml::parse_full>(xmlString);
+    context.xmlTree.parse<rapidxml::parse_full>(context.svgFile.GetData());
   }
   catch (rapidxml::parse_error err) {
     throw std::exception("Error in the svg file");
@@ -69,88 +49,177 @@ void srm::translator_t::SetSvg(const std::string &svgFileName) {
 
 /**
  * Collect all tags from DOM to list
+ * @param[in, out] arena arena to allocate tags
  * @param[in] node starting node in the xml DOM
  * @param[out] tags pointer to list of pointers to tags
  * @see GenCode
  */
-static void _getTags(rapidxml::xml_node<> *node, std::list<srm::tag_t *> *tags, unsigned int lvl) noexcept {
+static void _getTags(srm::arena_t *arena, rapidxml::xml_node<> *node, std::vector<srm::tag_t *> *tags, unsigned int lvl) {
   std::string nodeName;
   while (node) {
-    srm::tag_t *tag = new srm::tag_t(node);
+    srm::tag_t *tag = arena->New<srm::tag_t>(node);
     nodeName.assign(node->name());
     if (nodeName == "g" || nodeName == "svg") {
       tag->level = lvl + 1;
       tags->push_back(tag);
-      _getTags(node->first_node(), tags, lvl + 1);
+      _getTags(arena, node->first_node(), tags, lvl + 1);
     }
     else {
       tag->level = lvl;
       tags->push_back(tag);
-      _getTags(node->first_node(), tags, lvl);
+      _getTags(arena, node->first_node(), tags, lvl);
     }
     node = node->next_sibling();
   }
 }
 
+/**
+ * Write program header with board points and motion parameters
+ * @param[in] out output stream
+ * @param[in] roboConf robot configuration
+ */
+static void _writeHeader(std::ostream &out, const srm::robot_conf_t &roboConf) {
+  srm::vec3_t p;
+  out << ".TRANS" << std::endl;
+  out << "\tP 0 0 0 0 0 0" << std::endl;
+  p = roboConf.GetP1();
+  out << "p1 " << p.x << " " << p.y << " " << p.z << " 0 0 0" << std::endl;
+  p = roboConf.GetP2();
+  out << "p2 " << p.x << " " << p.y << " " << p.z << " 0 0 0" << std::endl;
+  p = roboConf.GetP3();
+  out << "p3 " << p.x << " " << p.y << " " << p.z << " 0 0 0" << std::endl;
+  out << ".END" << std::endl;
+
+  out << ".PROGRAM " << roboConf.GetProgramName()  << "()" << std::endl;
+  out << "\tHERE .#start" << std::endl;
+  out << "\tSPEED " << roboConf.GetVelocity() << " MM/S ALWAYS" << std::endl;
+  out << "\tACCURACY " << roboConf.GetRoboAcc() << std::endl;
+  out << "\tCP off" << std::endl;
+  out << "\tPOINT frm = FRAME(p1, p2, p3, p1)" << std::endl;
+}
+
+/**
+ * Write code of primitives
+ * @param[in] out output stream
+ * @param[in] geom geometry with primitives to write
+ * @param[in, out] ctx conversion context
+ */
+static void _writePrimitives(std::ostream &out, const srm::geometry_t &geom, srm::conversion_context_t *ctx) {
+  const uint8_t subpathFill = srm::geometry_t::fill | srm::geometry_t::subpath;
+  size_t regionBegin = 0;
+
+  for (size_t prim = 0; prim < geom.Size(); prim++) {
+    geom.GenCode(out, ctx->roboConf, prim, &ctx->codeBuf);
+    out << ";\n";
+    ctx->stats.primitives++;
+    ctx->stats.segments += geom.GetNumOfSegments(prim);
+    if (!(geom.flags[prim] & srm::geometry_t::fill))
+      continue;
+    if (!(geom.flags[prim] & srm::geometry_t::subpath))
+      regionBegin = prim;
+    // region is filled after outlines of all its contours
+    if (prim + 1 == geom.Size() || (geom.flags[prim + 1] & subpathFill) != subpathFill)
+      ctx->stats.segments += srm::FillRegion(ctx, out, geom, regionBegin, prim + 1);
+  }
+}
+
+/**
+ * Write program footer
+ * @param[in] out output stream
+ */
+static void _writeFooter(std::ostream &out) {
+  out << "\tJMOVE .#start" << std::endl;
+  out << ".END";
+}
+
 /**
  * Gen robot code from created tag tree
  * @param[in] codeFileName code file name
  * @see SetSvg
  */
-void srm::translator_t::GenCode(const std::string &codeFileName) const {
-  if (!xmlTree.first_node())
+void srm::translator_t::GenCode(const std::string &codeFileName) {
+  if (!context.xmlTree.first_node())
     throw std::exception("Svg file is not set or empty");
-  std::list<srm::tag_t *> tags;
-  _getTags(xmlTree.first_node(), &tags, 0);
-  
-  std::list<srm::primitive_t *> primitives;
-  srm::TagsToPrimitives(tags, &primitives);
-  srm::SplitPrimitives(&primitives);
-
-  for (auto tag : tags)
-    delete tag;
 
   std::ofstream fout(codeFileName);
-  if (!fout.is_open()) {
-    for (auto primitive : primitives)
-      delete primitive;
+  if (!fout.is_open())
     throw std::exception("Failed to open or create output file");
-  }
 
-  vec3_t p;
-  fout << ".TRANS" << std::endl;
-  fout << "\tP 0 0 0 0 0 0" << std::endl;
-  p = roboConf.GetP1();
-  fout << "p1 " << p.x << " " << p.y << " " << p.z << " 0 0 0" << std::endl;
-  p = roboConf.GetP2();
-  fout << "p2 " << p.x << " " << p.y << " " << p.z << " 0 0 0" << std::endl;
-  p = roboConf.GetP3();
-  fout << "p3 " << p.x << " " << p.y << " " << p.z << " 0 0 0" << std::endl;
-  fout << ".END" << std::endl;
-
-  fout << ".PROGRAM " << roboConf.GetProgramName()  << "()" << std::endl;
-  fout << "\tHERE .#start" << std::endl;
-  fout << "\tSPEED " << roboConf.GetVelocity() << " MM/S ALWAYS" << std::endl;
-  fout << "\tACCURACY " << roboConf.GetRoboAcc() << std::endl;
-  fout << "\tCP off" << std::endl;
-  fout << "\tPOINT frm = FRAME(p1, p2, p3, p1)" << std::endl;
-
-  for (auto primitive : primitives) {
-    fout << *primitive << ";\n";
-    if (primitive->fill)
-      FillPrimitive(fout, *primitive);
+  GenCode(fout);
+}
+
+/**
+ * Gen robot code from created tag tree to output stream
+ * @param[in] out output stream
+ * @see SetSvg
+ */
+void srm::translator_t::GenCode(std::ostream &out) {
+  if (!context.xmlTree.first_node())
+    throw std::exception("Svg file is not set or empty");
+
+  // tags and geometry are freed at once on any exit, memory is kept for next conversion
+  context.stats.Clear();
+  try {
+    _getTags(&context.arena, context.xmlTree.first_node(), &context.tags, 0);
+    srm::TagsToPrimitives(&context, context.tags, &context.shapes);
+    srm::SplitPrimitives(&context, context.shapes, &context.splitted);
+
+    _writeHeader(out, context.roboConf);
+    _writePrimitives(out, context.splitted, &context);
+    _writeFooter(out);
   }
+  catch (std::exception &) {
+    context.Release();
+    throw;
+  }
+  context.Release();
+}
 
-  fout << "\tJMOVE .#start" << std::endl;
-  fout << ".END";
+/**
+ * Gen robot code from svg file without building DOM. Each element is converted and written as soon as it is read
+ * @param[in] svgFileName path to file with svg image
+ * @param[in] codeFileName code file name
+ */
+void srm::translator_t::GenCodeStream(const std::string &svgFileName, const std::string &codeFileName) {
+  svg_stream_t svgStream(svgFileName);
+
+  std::ofstream fout(codeFileName);
+  if (!fout.is_open())
+    throw std::exception("Failed to open or create output file");
+
+  tags_translator_t tagsTranslator(&context, &context.shapes);
 
-  for (auto primitive : primitives)
-    delete primitive;
+  context.stats.Clear();
+  _writeHeader(fout, context.roboConf);
+  try {
+    svgStream.Parse([&](const tag_t &tag) {
+      tagsTranslator.Process(tag);
+      if (context.shapes.Size() > 0) {
+        srm::SplitPrimitives(&context, context.shapes, &context.splitted);
+        _writePrimitives(fout, context.splitted, &context);
+        context.shapes.Clear();
+        context.splitted.Clear();
+      }
+      });
+  }
+  catch (std::exception &) {
+    context.Release();
+    throw;
+  }
+  _writeFooter(fout);
+  context.Release();
+}
+
+/**
+ * Get statistics of the last conversion function
+ * @return conversion statistics
+ */
+const srm::stats_t & srm::translator_t::GetStats(void) const noexcept {
+  return context.stats;
 }
 
 /**
  * Translator class destructor
  */
 srm::translator_t::~translator_t(void) noexcept{
-  delete[] xmlString;
 }
@@ -14,44 +14,28 @@
 
 #include <string>
 #include <ostream>
+#include <iostream>
 #include "rapidxml.hpp"
 #include "robot_conf/robot_conf.h"
+#include "context/context.h"
 
 /** \brief Project namespace */
 namespace srm {
   /**
    * @brief Main converter class
    *
-   * Contains method to parse svg file and create code
+   * Contains method to parse svg file and create code.
+   * Each translator owns its conversion context, so different translators may work in parallel.
    */
   class translator_t {
-  private:
-    static translator_t singleToneVar;  ///< tranlator singletone variable
-
-    rapidxml::xml_document<> xmlTree;   ///< the root of xml DOM
-    char *xmlString;                    ///< rapidxml needs this char string for its work
-
-    std::ostream *logStream;            ///< stream to make logs
-
-    /**
-     * Private constructor for single tone
-     */
-    translator_t(void) noexcept;
-
   public:
-    robot_conf_t roboConf;              ///< robot configuration
+    conversion_context_t context;       ///< conversion context with DOM, robot configuration and logging sink
 
     /**
-     * Get 'translator_t' class single tone variable
-     * @return pointer to single tone variable
+     * Constructor for translator_t
+     * @param[in] log stream to make logs
      */
-    static translator_t * GetPtr(void) noexcept;
-
-    /**
-     * Write string in log stream function
-     * @param[in] str string to write
-     */
-    void WriteLog(const std::string &str) noexcept;
+    translator_t(std::ostream *log = &std::cout) noexcept;
 
     /**
      * @defgroup converterFuncs Main functions to convert
@@ -66,15 +50,41 @@ namespace srm {
       */
     void SetSvg(const std::string &svgFileName);
 
+    /**
+     * Set already loaded svg image to convert function. Create tag tree
+     * @param[in] file loaded svg file (is moved to translator)
+     */
+    void SetSvg(svg_file_t &&file);
+
     /**
      * Gen robot code from created tag tree
      * @param[in] codeFileName code file name
      * @see SetSvg
      */
-    void GenCode(const std::string &codeFileName) const;
+    void GenCode(const std::string &codeFileName);
+
+    /**
+     * Gen robot code from created tag tree to output stream
+     * @param[in] out output stream
+     * @see SetSvg
+     */
+    void GenCode(std::ostream &out);
+
+    /**
+     * Gen robot code from svg file without building DOM. Each element is converted and written as soon as it is read
+     * @param[in] svgFileName path to file with svg image
+     * @param[in] codeFileName code file name
+     */
+    void GenCodeStream(const std::string &svgFileName, const std::string &codeFileName);
 
     /**@}*/
 
+    /**
+     * Get statistics of the last conversion function
+     * @return conversion statistics
+     */
+    const stats_t & GetStats(void) const noexcept;
+
     /**
      * Translator class destructor
      */
@@ -14,7 +14,9 @@
  * Converter from svg image format to Kawasaki robot motions for robowizard.
  */
 
+#include <algorithm>
 #include <iostream>
+#include <thread>
 #include <srm.h>
 
 /**
@@ -24,25 +26,57 @@
  * @return system code (0 if success)
  */
 int main(int argC, char *argV[]) {
+  if (argC > 1 && std::string(argV[1]) == "-bench")
+    return srm::bench::Run(argC - 2, argV + 2);
+
+  // batch mode: convert files from manifest on worker pool
+  if (argC > 1 && std::string(argV[1]) == "-batch") {
+    if (argC != 3 && argC != 4) {
+      std::cout << "Error: wrong params" << std::endl;
+      return 0;
+    }
+    try {
+      unsigned numOfThreads = argC == 4 ? (unsigned)std::atoi(argV[3]) : std::thread::hardware_concurrency();
+      srm::ConvertBatch(argV[2], numOfThreads, std::cout);
+    }
+    catch (std::exception &e) {
+      std::cout << "Error: " << e.what() << std::endl;
+    }
+    return 0;
+  }
+
+  // streaming mode: convert without building full DOM
+  bool isStream = argC > 1 && std::string(argV[1]) == "-stream";
+  if (isStream) {
+    argC--;
+    argV++;
+  }
+
   if (argC != 3 && argC != 4) {
     std::cout << "Error: wrong params" << std::endl;
     return 0;
   }
 
   try {
-    srm::translator_t *trans = srm::translator_t::GetPtr();
+    srm::translator_t trans;
+    // the only file is converted, so all cores hatch big fill regions
+    trans.context.numOfFillThreads = std::max(1u, std::thread::hardware_concurrency());
 
     if (argC == 4)
-      trans->roboConf.LoadConf(argV[3]);
-    trans->SetSvg(argV[1]);
-    trans->GenCode(argV[2]);
+      trans.context.roboConf.LoadConf(argV[3]);
+    if (isStream)
+      trans.GenCodeStream(argV[1], argV[2]);
+    else {
+      trans.SetSvg(argV[1]);
+      trans.GenCode(argV[2]);
+    }
+    std::cout << "Success" << std::endl;
+    std::cout << trans.GetStats() << std::endl;
   }
   catch (std::exception &e) {
     std::cout << "Error: " << e.what() << std::endl;
     return 0;
   }
-
-  std::cout << "Success" << std::endl;
  
   return 0;
 }
@@ -17,18 +17,35 @@
 
 #include "converter/defs.h"
 #include "converter/translator.h"
+#include "converter/svg_file/svg_file.h"
+#include "converter/arena/arena.h"
 #include "converter/rapidxml.hpp"
-#include "converter/primitive/primitive.h"
+#include "converter/kernels/kernels.h"
+#include "converter/geometry/geometry.h"
+#include "converter/shape_cache/shape_cache.h"
 #include "converter/split_primitives/split_prims.h"
 #include "converter/tags_translator/tag/tag.h"
-#include "converter/tags_translator/tags_translator.h"
 #include "converter/tags_translator/path/bezier/bezier.h"
+#include "converter/tags_translator/path/bezier/bezier_batch.h"
 #include "converter/tags_translator/ellipse/ellipse.h"
+#include "converter/tags_translator/svg_num/svg_num.h"
 #include "converter/tags_translator/transform/transform.h"
+#include "converter/tags_translator/transform/transform_cache.h"
 #include "converter/tags_translator/path/path.h"
+#include "converter/tags_translator/tags_translator.h"
+#include "converter/svg_stream/svg_stream.h"
 #include "converter/robot_conf/robot_conf.h"
 #include "converter/robot_conf/cs/cs.h"
 #include "converter/split_primitives/split_prims.h"
+#include "converter/fill/scanline/scanline.h"
+#include "converter/fill/cells/cells.h"
+#include "converter/fill/offset/offset.h"
+#include "converter/fill/angle/angle.h"
 #include "converter/fill/fill.h"
+#include "converter/stats/stats.h"
+#include "converter/context/context.h"
+#include "converter/batch/batch.h"
+
+#include "bench/bench.h"
 
 #endif /* __SRM_H_INCLUDED */